@@ -393,6 +393,6 @@ static const GFXglyph FreeMonoOblique18pt7bGlyphs[]  = {
 const GFXfont FreeMonoOblique18pt7b  = {
   (uint8_t  *)FreeMonoOblique18pt7bBitmaps,
   (GFXglyph *)FreeMonoOblique18pt7bGlyphs,
-  0x20, 0x7E, 35 };
+  0x20, 0x7E, 35, NULL, 0, NULL, NULL, NULL };
 
 // Approx. 4186 bytes
@@ -182,6 +182,6 @@ static const GFXglyph FreeMonoOblique9pt7bGlyphs[]  = {
 const GFXfont FreeMonoOblique9pt7b  = {
   (uint8_t  *)FreeMonoOblique9pt7bBitmaps,
   (GFXglyph *)FreeMonoOblique9pt7bGlyphs,
-  0x20, 0x7E, 18 };
+  0x20, 0x7E, 18, NULL, 0, NULL, NULL, NULL };
 
 // Approx. 1654 bytes
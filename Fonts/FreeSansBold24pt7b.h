@@ -779,6 +779,6 @@ static const GFXglyph FreeSansBold24pt7bGlyphs[]  = {
 const GFXfont FreeSansBold24pt7b  = {
   (uint8_t  *)FreeSansBold24pt7bBitmaps,
   (GFXglyph *)FreeSansBold24pt7bGlyphs,
-  0x20, 0x7E, 56 };
+  0x20, 0x7E, 56, NULL, 0, NULL, NULL, NULL };
 
 // Approx. 8815 bytes
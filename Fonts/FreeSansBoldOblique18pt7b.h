@@ -540,6 +540,6 @@ static const GFXglyph FreeSansBoldOblique18pt7bGlyphs[]  = {
 const GFXfont FreeSansBoldOblique18pt7b  = {
   (uint8_t  *)FreeSansBoldOblique18pt7bBitmaps,
   (GFXglyph *)FreeSansBoldOblique18pt7bGlyphs,
-  0x20, 0x7E, 42 };
+  0x20, 0x7E, 42, NULL, 0, NULL, NULL, NULL };
 
 // Approx. 5943 bytes
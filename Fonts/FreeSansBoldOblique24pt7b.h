@@ -888,6 +888,6 @@ static const GFXglyph FreeSansBoldOblique24pt7bGlyphs[]  = {
 const GFXfont FreeSansBoldOblique24pt7b  = {
   (uint8_t  *)FreeSansBoldOblique24pt7bBitmaps,
   (GFXglyph *)FreeSansBoldOblique24pt7bGlyphs,
-  0x20, 0x7E, 56 };
+  0x20, 0x7E, 56, NULL, 0, NULL, NULL, NULL };
 
 // Approx. 10119 bytes
@@ -297,6 +297,6 @@ static const GFXglyph FreeSansOblique12pt7bGlyphs[]  = {
 const GFXfont FreeSansOblique12pt7b  = {
   (uint8_t  *)FreeSansOblique12pt7bBitmaps,
   (GFXglyph *)FreeSansOblique12pt7bGlyphs,
-  0x20, 0x7E, 29 };
+  0x20, 0x7E, 29, NULL, 0, NULL, NULL, NULL };
 
 // Approx. 3034 bytes
@@ -513,6 +513,6 @@ static const GFXglyph FreeSansOblique18pt7bGlyphs[]  = {
 const GFXfont FreeSansOblique18pt7b  = {
   (uint8_t  *)FreeSansOblique18pt7bBitmaps,
   (GFXglyph *)FreeSansOblique18pt7bGlyphs,
-  0x20, 0x7E, 42 };
+  0x20, 0x7E, 42, NULL, 0, NULL, NULL, NULL };
 
 // Approx. 5623 bytes
@@ -835,6 +835,6 @@ static const GFXglyph FreeSansOblique24pt7bGlyphs[]  = {
 const GFXfont FreeSansOblique24pt7b  = {
   (uint8_t  *)FreeSansOblique24pt7bBitmaps,
   (GFXglyph *)FreeSansOblique24pt7bGlyphs,
-  0x20, 0x7E, 56 };
+  0x20, 0x7E, 56, NULL, 0, NULL, NULL, NULL };
 
 // Approx. 9483 bytes
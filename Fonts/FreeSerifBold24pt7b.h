@@ -754,6 +754,6 @@ static const GFXglyph FreeSerifBold24pt7bGlyphs[]  = {
 const GFXfont FreeSerifBold24pt7b  = {
   (uint8_t  *)FreeSerifBold24pt7bBitmaps,
   (GFXglyph *)FreeSerifBold24pt7bGlyphs,
-  0x20, 0x7E, 56 };
+  0x20, 0x7E, 56, NULL, 0, NULL, NULL, NULL };
 
 // Approx. 8519 bytes
@@ -197,6 +197,6 @@ static const GFXglyph FreeSerifBold9pt7bGlyphs[]  = {
 const GFXfont FreeSerifBold9pt7b  = {
   (uint8_t  *)FreeSerifBold9pt7bBitmaps,
   (GFXglyph *)FreeSerifBold9pt7bGlyphs,
-  0x20, 0x7E, 22 };
+  0x20, 0x7E, 22, NULL, 0, NULL, NULL, NULL };
 
 // Approx. 1834 bytes
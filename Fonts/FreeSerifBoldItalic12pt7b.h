@@ -287,6 +287,6 @@ static const GFXglyph FreeSerifBoldItalic12pt7bGlyphs[]  = {
 const GFXfont FreeSerifBoldItalic12pt7b  = {
   (uint8_t  *)FreeSerifBoldItalic12pt7bBitmaps,
   (GFXglyph *)FreeSerifBoldItalic12pt7bGlyphs,
-  0x20, 0x7E, 29 };
+  0x20, 0x7E, 29, NULL, 0, NULL, NULL, NULL };
 
 // Approx. 2910 bytes
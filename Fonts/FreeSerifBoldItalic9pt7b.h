@@ -210,6 +210,6 @@ static const GFXglyph FreeSerifBoldItalic9pt7bGlyphs[]  = {
 const GFXfont FreeSerifBoldItalic9pt7b  = {
   (uint8_t  *)FreeSerifBoldItalic9pt7bBitmaps,
   (GFXglyph *)FreeSerifBoldItalic9pt7bGlyphs,
-  0x20, 0x7E, 22 };
+  0x20, 0x7E, 22, NULL, 0, NULL, NULL, NULL };
 
 // Approx. 1982 bytes
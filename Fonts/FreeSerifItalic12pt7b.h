@@ -266,6 +266,6 @@ static const GFXglyph FreeSerifItalic12pt7bGlyphs[]  = {
 const GFXfont FreeSerifItalic12pt7b  = {
   (uint8_t  *)FreeSerifItalic12pt7bBitmaps,
   (GFXglyph *)FreeSerifItalic12pt7bGlyphs,
-  0x20, 0x7E, 29 };
+  0x20, 0x7E, 29, NULL, 0, NULL, NULL, NULL };
 
 // Approx. 2656 bytes
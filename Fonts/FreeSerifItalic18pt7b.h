@@ -445,6 +445,6 @@ static const GFXglyph FreeSerifItalic18pt7bGlyphs[]  = {
 const GFXfont FreeSerifItalic18pt7b  = {
   (uint8_t  *)FreeSerifItalic18pt7bBitmaps,
   (GFXglyph *)FreeSerifItalic18pt7bGlyphs,
-  0x20, 0x7E, 42 };
+  0x20, 0x7E, 42, NULL, 0, NULL, NULL, NULL };
 
 // Approx. 4805 bytes
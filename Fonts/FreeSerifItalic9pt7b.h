@@ -197,6 +197,6 @@ static const GFXglyph FreeSerifItalic9pt7bGlyphs[]  = {
 const GFXfont FreeSerifItalic9pt7b  = {
   (uint8_t  *)FreeSerifItalic9pt7bBitmaps,
   (GFXglyph *)FreeSerifItalic9pt7bGlyphs,
-  0x20, 0x7E, 22 };
+  0x20, 0x7E, 22, NULL, 0, NULL, NULL, NULL };
 
 // Approx. 1835 bytes
@@ -126,6 +126,6 @@ static const GFXglyph Org_01Glyphs[]  = {
 const GFXfont Org_01  = {
   (uint8_t  *)Org_01Bitmaps,
   (GFXglyph *)Org_01Glyphs,
-  0x20, 0x7E, 7 };
+  0x20, 0x7E, 7, NULL, 0, NULL, NULL, NULL };
 
 // Approx. 943 bytes
@@ -118,6 +118,6 @@ static const GFXglyph PicopixelGlyphs[]  = {
 const GFXfont Picopixel  = {
   (uint8_t  *)PicopixelBitmaps,
   (GFXglyph *)PicopixelGlyphs,
-  0x20, 0x7E, 7 };
+  0x20, 0x7E, 7, NULL, 0, NULL, NULL, NULL };
 
 // Approx. 852 bytes
@@ -267,6 +267,6 @@ static const GFXglyph Boring_Boron32pt7bGlyphs[]  = {
 const GFXfont Boring_Boron32pt7b  = {
   (uint8_t  *)Boring_Boron32pt7bBitmaps,
   (GFXglyph *)Boring_Boron32pt7bGlyphs,
-  0x20, 0x39, 77 };
+  0x20, 0x39, 77, NULL, 0, NULL, NULL, NULL };
 
 // Approx. 3011 bytes
@@ -378,6 +378,6 @@ static const GFXglyph Xanadu32pt7bGlyphs[]  = {
 const GFXfont Xanadu32pt7b  = {
   (uint8_t  *)Xanadu32pt7bBitmaps,
   (GFXglyph *)Xanadu32pt7bGlyphs,
-  0x20, 0x39, 63 };
+  0x20, 0x39, 63, NULL, 0, NULL, NULL, NULL };
 
 // Approx. 4352 bytes
@@ -1,13 +1,24 @@
 /**
-  *@file FifoTest.cpp
-  *@brief unit tests for the Fifo class
+  *@file MonoGfx_UT.cpp
+  *@brief unit tests for the mono_gfx module
   *@author Jason Berger
   *@date 02/16/2019
   */
 #ifdef UNIT_TESTING_ENABLED
 
 #include "mono_gfx.c"
+#include "mono_gfx_font_file.c"
+#include "mono_gfx_text_field.c"
+#include "mono_gfx_text_cache.c"
+#include "mono_gfx_term.c"
+#include "mono_gfx_font_pager.c"
+#include "mono_gfx_dither.c"
+#include "Fonts/FreeSans9pt7b.h"
+#include "Fonts/FreeMono9pt7b.h"
 #include <gtest/gtest.h>
+#include <math.h>
+#include <vector>
+#include <chrono>
 
 
 
@@ -36,6 +47,39 @@ const uint8_t compRect[] = {
 };
 
 
+//2x2 solid block used for every glyph in the test font
+const uint8_t testFontBitmaps[] = { 0xF0 };
+
+const GFXglyph testFontGlyphs[] = {
+  { 0, 2, 2, 3, 0, -2 }, // 0x41 'A'
+  { 0, 2, 2, 3, 0, -2 }, // 0x42 'B'
+  { 0, 2, 2, 4, 0, -2 }, // U+00E9
+  { 0, 2, 2, 5, 0, -2 }  // U+2603
+};
+
+const GFXrange testFontRanges[] = {
+  { 0x00E9, 0x00E9, 2 },
+  { 0x2603, 0x2603, 3 }
+};
+
+const GFXfont testFont = {
+  (uint8_t  *)testFontBitmaps,
+  (GFXglyph *)testFontGlyphs,
+  0x41, 0x42, 4,
+  testFontRanges, 2, NULL, NULL, NULL };
+
+//'A' followed by 'B' is pulled in by 1 pixel
+const uint16_t testKernIndex[] = { 0, 1, 1, 1, 1 };
+const GFXkernPair testKernPairs[] = { { 1, -1 } };
+const GFXkern testKern = { testKernIndex, testKernPairs, 4 };
+
+const GFXfont testFontKerned = {
+  (uint8_t  *)testFontBitmaps,
+  (GFXglyph *)testFontGlyphs,
+  0x41, 0x42, 4,
+  testFontRanges, 2,
+  &testKern, NULL, NULL };
+
 mono_gfx_t canvas;
 
 //Test drawing a rectangle
@@ -45,7 +89,7 @@ TEST(MonoGfxTest, rectTest)
 
     mono_gfx_draw_rect(&canvas, 1,1,6,6, 1);
 
-    for(int i=0; i < canvas.mBufferSize; i++)
+    for(uint32_t i=0; i < canvas.mBufferSize; i++)
     {
       ASSERT_EQ(compRect[i], canvas.mBuffer[i]) << "failed at index:" << i ;
     }
@@ -60,7 +104,7 @@ TEST(MonoGfxTest, lineTest)
 
     mono_gfx_draw_line(&canvas, 0,0,7,7,1);
 
-    for(int i=0; i < canvas.mBufferSize; i++)
+    for(uint32_t i=0; i < canvas.mBufferSize; i++)
     {
       ASSERT_EQ(compLine[i], canvas.mBuffer[i]) << "failed at index:" << i ;
     }
@@ -68,4 +112,2077 @@ TEST(MonoGfxTest, lineTest)
     mono_gfx_deinit(&canvas);
 }
 
+//Test decoding utf8 and looking up glyphs from sparse ranges
+TEST(MonoGfxTest, utf8Test)
+{
+    const char* text = "A\xC3\xA9\xE2\x98\x83\x80";
+
+    ASSERT_EQ(0x41u, mono_gfx_utf8_next(&text));
+    ASSERT_EQ(0xE9u, mono_gfx_utf8_next(&text));
+    ASSERT_EQ(0x2603u, mono_gfx_utf8_next(&text));
+    ASSERT_EQ(0xFFFDu, mono_gfx_utf8_next(&text)); //stray continuation byte
+    ASSERT_EQ(0u, mono_gfx_utf8_next(&text));
+
+    ASSERT_EQ(&testFontGlyphs[1], mono_gfx_get_glyph(&testFont, 'B'));
+    ASSERT_EQ(&testFontGlyphs[2], mono_gfx_get_glyph(&testFont, 0xE9));
+    ASSERT_EQ(&testFontGlyphs[3], mono_gfx_get_glyph(&testFont, 0x2603));
+    ASSERT_EQ(NULL, mono_gfx_get_glyph(&testFont, 0x2604));
+
+    int w,h;
+    mono_gfx_init_buffered(&canvas, 16,8);
+    canvas.mFont = &testFont;
+    mono_gfx_measure(&canvas, "A\xC3\xA9\xE2\x98\x83\nB", &w, &h);
+    ASSERT_EQ(12, w);
+    ASSERT_EQ(8, h);
+
+    mono_gfx_print(&canvas, 0, 2, "\xC3\xA9" "B", 1);
+    ASSERT_EQ(0xCC, canvas.mBuffer[0]); // 1 1 _ _ 1 1 _ _ , glyphs at x=0 and x=4
+    ASSERT_EQ(0xCC, canvas.mBuffer[2]);
+    mono_gfx_deinit(&canvas);
+}
+
+//Test applying kerning pairs
+TEST(MonoGfxTest, kerningTest)
+{
+    int w,h;
+    mono_gfx_init_buffered(&canvas, 16,8);
+    canvas.mFont = &testFontKerned;
+
+    ASSERT_EQ(-1, mono_gfx_get_kerning(&testFontKerned, &testFontGlyphs[0], &testFontGlyphs[1]));
+    ASSERT_EQ(0, mono_gfx_get_kerning(&testFontKerned, &testFontGlyphs[1], &testFontGlyphs[0]));
+
+    mono_gfx_measure(&canvas, "ABA", &w, &h);
+    ASSERT_EQ(8, w);
+
+    mono_gfx_print(&canvas, 0, 2, "AB", 1);
+    ASSERT_EQ(0xF0, canvas.mBuffer[0]); // 1 1 1 1 _ _ _ _ , B pulled in against A
+    mono_gfx_deinit(&canvas);
+}
+
+//Test writing a font to a binary file and using it from the mapping
+TEST(MonoGfxTest, fontFileTest)
+{
+    mono_gfx_font_file_t file;
+    const char* path = "mono_gfx_font_file_test.bin";
+
+    ASSERT_EQ(MRT_STATUS_OK, mono_gfx_font_file_write(&testFontKerned, path));
+    ASSERT_EQ(MRT_STATUS_OK, mono_gfx_font_file_open(&file, path));
+
+    ASSERT_EQ(testFontKerned.first, file.mFont.first);
+    ASSERT_EQ(testFontKerned.last, file.mFont.last);
+    ASSERT_EQ(2, file.mFont.rangeCount);
+    ASSERT_EQ(5, mono_gfx_get_glyph(&file.mFont, 0x2603)->xAdvance);
+    ASSERT_EQ(-1, mono_gfx_get_kerning(&file.mFont, &file.mFont.glyph[0], &file.mFont.glyph[1]));
+
+    mono_gfx_init_buffered(&canvas, 16,8);
+    canvas.mFont = &file.mFont;
+    mono_gfx_print(&canvas, 0, 2, "AB", 1);
+    ASSERT_EQ(0xF0, canvas.mBuffer[0]);
+    mono_gfx_deinit(&canvas);
+    mono_gfx_font_file_close(&file);
+
+    //range count that does not fit in GFXfont::rangeCount
+    FILE* fp = fopen(path, "r+b");
+    uint32_t rangeCount = 0x10002;
+    fseek(fp, offsetof(mono_gfx_font_file_header_t, rangeCount), SEEK_SET);
+    fwrite(&rangeCount, sizeof(rangeCount), 1, fp);
+    fclose(fp);
+    ASSERT_EQ(MRT_STATUS_ERROR, mono_gfx_font_file_open(&file, path));
+
+    //corrupt a glyph so its bitmap runs off the end of the file
+    ASSERT_EQ(MRT_STATUS_OK, mono_gfx_font_file_write(&testFontKerned, path));
+    fp = fopen(path, "r+b");
+    fseek(fp, sizeof(mono_gfx_font_file_header_t), SEEK_SET);
+    int badOffset = 1000;
+    fwrite(&badOffset, sizeof(badOffset), 1, fp);
+    fclose(fp);
+    ASSERT_EQ(MRT_STATUS_ERROR, mono_gfx_font_file_open(&file, path));
+
+    remove(path);
+}
+
+//Test reading glyph bitmaps in pages from a font file
+TEST(MonoGfxTest, pagedFontTest)
+{
+    mono_gfx_t ref;
+    mono_gfx_font_file_t file;
+    mono_gfx_font_pager_t pager;
+    const char* path = "mono_gfx_paged_font_test.bin";
+    const char* text = "The quick brown fox\njumps over 12 lazy dogs";
+
+    ASSERT_EQ(MRT_STATUS_OK, mono_gfx_font_file_write(&FreeSans9pt7b, path));
+    ASSERT_EQ(MRT_STATUS_OK, mono_gfx_font_file_open_paged(&file, path, &pager));
+    ASSERT_TRUE(file.mFont.bitmap == NULL);
+
+    mono_gfx_init_buffered(&canvas, 200,48);
+    mono_gfx_init_buffered(&ref, 200,48);
+    canvas.mFont = &file.mFont;
+    ref.mFont = &FreeSans9pt7b;
+
+    for(int rot=0; rot < 2; rot++)
+    {
+      canvas.mTextRotation = rot ? MONO_GFX_ROTATE_180 : MONO_GFX_ROTATE_0;
+      ref.mTextRotation = canvas.mTextRotation;
+      mono_gfx_fill(&canvas, 0);
+      mono_gfx_fill(&ref, 0);
+      mono_gfx_print(&canvas, rot ? 190 : 2, rot ? 30 : 14, text, 1);
+      mono_gfx_print(&ref, rot ? 190 : 2, rot ? 30 : 14, text, 1);
+
+      for(uint32_t i=0; i < canvas.mBufferSize; i++)
+      {
+        ASSERT_EQ(ref.mBuffer[i], canvas.mBuffer[i]) << "rotation " << rot << " failed at index:" << i ;
+      }
+    }
+
+    //the whole font fits in the cache, so printing again should not read anything
+    uint32_t misses = pager.mMisses;
+    ASSERT_GT(misses, 0u);
+    canvas.mTextRotation = MONO_GFX_ROTATE_0;
+    mono_gfx_print(&canvas, 2, 14, text, 1);
+    ASSERT_EQ(misses, pager.mMisses);
+    ASSERT_GT(pager.mHits, 0u);
+
+    mono_gfx_deinit(&canvas);
+    mono_gfx_deinit(&ref);
+    mono_gfx_font_file_close(&file);
+    remove(path);
+}
+
+//Test scaled bitmaps against drawing each pixel as a block
+TEST(MonoGfxTest, scaleTest)
+{
+    mono_gfx_t ref;
+    uint8_t data[20];
+    GFXBmp bmp = { data, 13, 11 };  //odd size so rows are not byte aligned
+
+    srand(1);
+    for(size_t i=0; i < sizeof(data); i++)
+      data[i] = rand();
+
+    for(int scale = 1; scale <= 5; scale++)
+    {
+      mono_gfx_init_buffered(&canvas, 72,64);
+      mono_gfx_init_buffered(&ref, 72,64);
+
+      mono_gfx_draw_bmp_scaled(&canvas, -3, 2, &bmp, scale, 1);
+
+      for(int i=0; i < bmp.height * bmp.width; i++)
+      {
+        if(data[i/8] & (0x80 >> (i%8)))
+          mono_gfx_draw_rect(&ref, -3 + (i % bmp.width)*scale, 2 + (i / bmp.width)*scale, scale, scale, 1);
+      }
+
+      for(uint32_t i=0; i < canvas.mBufferSize; i++)
+      {
+        ASSERT_EQ(ref.mBuffer[i], canvas.mBuffer[i]) << "scale " << scale << " failed at index:" << i ;
+      }
+
+      mono_gfx_deinit(&canvas);
+      mono_gfx_deinit(&ref);
+    }
+
+    //2x text
+    int w,h;
+    mono_gfx_init_buffered(&canvas, 16,8);
+    canvas.mFont = &testFont;
+    canvas.mTextScale = 2;
+    mono_gfx_measure(&canvas, "AB", &w, &h);
+    ASSERT_EQ(12, w);
+    ASSERT_EQ(8, h);
+    mono_gfx_print(&canvas, 0, 4, "AB", 1);
+    for(int i=0; i < 4; i++)
+    {
+      ASSERT_EQ(0xF3, canvas.mBuffer[i*2]); // 1 1 1 1 _ _ 1 1
+      ASSERT_EQ(0xC0, canvas.mBuffer[i*2 + 1]);
+    }
+    mono_gfx_deinit(&canvas);
+}
+
+//Test synthetic bold and oblique on a vertical bar
+TEST(MonoGfxTest, styleTest)
+{
+    const uint8_t barBitmap[] = { 0xFF };
+    const GFXglyph barGlyph[] = { { 0, 1, 8, 2, 0, -8 } }; // '|'
+    const GFXfont barFont = { (uint8_t*)barBitmap, (GFXglyph*)barGlyph, '|', '|', 8, NULL, 0, NULL, NULL, NULL };
+    int w,h;
+
+    mono_gfx_init_buffered(&canvas, 8,8);
+    canvas.mFont = &barFont;
+    canvas.mTextStyle = MONO_GFX_STYLE_BOLD | MONO_GFX_STYLE_OBLIQUE;
+
+    mono_gfx_measure(&canvas, "||", &w, &h);
+    ASSERT_EQ(6, w);
+
+    mono_gfx_print(&canvas, 1, 8, "|", 1);
+    for(int i=0; i < 4; i++)
+    {
+      ASSERT_EQ(0x30, canvas.mBuffer[i]) << "failed at row:" << i; // _ _ 1 1 _ _ _ _
+      ASSERT_EQ(0x60, canvas.mBuffer[i + 4]) << "failed at row:" << i + 4; // _ 1 1 _ _ _ _ _
+    }
+    mono_gfx_deinit(&canvas);
+}
+
+//Test that a text field only redraws changed cells and ends up matching a full reprint
+TEST(MonoGfxTest, textFieldTest)
+{
+    mono_gfx_t ref;
+    mono_gfx_text_field_t field;
+    GFXrect dirty;
+    const char* updates[] = { "12:30", "12:31", "12:41", "9:41", "12:41" };
+
+    mono_gfx_init_buffered(&canvas, 64,16);
+    mono_gfx_init_buffered(&ref, 64,16);
+    canvas.mFont = &FreeSans9pt7b;
+    ref.mFont = &FreeSans9pt7b;
+
+    mono_gfx_text_field_init(&field, &canvas, 2, 1, 60, 14, 13);
+
+    for(int u=0; u < 5; u++)
+    {
+      mono_gfx_text_field_update(&field, updates[u]);
+      mono_gfx_fill(&ref, 0);
+      mono_gfx_print(&ref, 2, 14, updates[u], 1);
+
+      for(uint32_t i=0; i < canvas.mBufferSize; i++)
+      {
+        ASSERT_EQ(ref.mBuffer[i], canvas.mBuffer[i]) << "update " << u << " failed at index:" << i ;
+      }
+
+      ASSERT_TRUE(mono_gfx_text_field_get_dirty(&field, &dirty));
+      if(u == 1)
+      {
+        //only the last digit changed
+        ASSERT_FALSE(field.mCells[3].mDirty);
+        ASSERT_TRUE(field.mCells[4].mDirty);
+        ASSERT_EQ(field.mCells[4].mLeft, dirty.x);
+      }
+    }
+
+    //no change, nothing to redraw
+    mono_gfx_text_field_update(&field, "12:41");
+    ASSERT_FALSE(mono_gfx_text_field_get_dirty(&field, &dirty));
+
+    //characters the canvas font does not have come from the fallback fonts, as they do for print
+    const GFXfont* fallbacks[] = { &testFont };
+    GFXfontChain chain;
+    mono_gfx_font_chain_init(&chain, fallbacks, 1);
+    canvas.mFontChain = &chain;
+    ref.mFontChain = &chain;
+    const char* chained[] = { "12\xE2\x98\x83", "1\xC3\xA9\xE2\x98\x83" };
+    for(int u=0; u < 2; u++)
+    {
+      ASSERT_EQ(MRT_STATUS_OK, mono_gfx_text_field_update(&field, chained[u]));
+      ASSERT_EQ(&testFont, field.mCells[2 - u].mFont);
+      mono_gfx_fill(&ref, 0);
+      mono_gfx_print(&ref, 2, 14, chained[u], 1);
+
+      for(uint32_t i=0; i < canvas.mBufferSize; i++)
+      {
+        ASSERT_EQ(ref.mBuffer[i], canvas.mBuffer[i]) << "chained update " << u << " failed at index:" << i ;
+      }
+    }
+
+    //text longer than the field can hold is turned down, and the field keeps what it showed
+    std::string full(MONO_GFX_TEXT_FIELD_MAX_CHARS, '1');
+    ASSERT_EQ(MRT_STATUS_OK, mono_gfx_text_field_update(&field, (full + "\n1").c_str()));
+    ASSERT_EQ(MONO_GFX_TEXT_FIELD_MAX_CHARS, field.mCount);
+    std::vector<uint8_t> before(canvas.mBuffer, canvas.mBuffer + canvas.mBufferSize);
+    ASSERT_EQ(MRT_STATUS_ERROR, mono_gfx_text_field_update(&field, (full + "2").c_str()));
+    ASSERT_EQ(MONO_GFX_TEXT_FIELD_MAX_CHARS, field.mCount);
+    ASSERT_EQ(0, memcmp(before.data(), canvas.mBuffer, canvas.mBufferSize));
+
+    //fields only lay out upright text
+    canvas.mTextRotation = MONO_GFX_ROTATE_90;
+    ASSERT_EQ(MRT_STATUS_ERROR, mono_gfx_text_field_update(&field, "12:41"));
+
+    mono_gfx_deinit(&canvas);
+    mono_gfx_deinit(&ref);
+}
+
+//Test rotated text against rotating upright text pixel by pixel
+TEST(MonoGfxTest, rotateTest)
+{
+    mono_gfx_t upright, rotated, cached, ref;
+    static mono_gfx_rot_cache_t rotCache;
+    const int ox = 40, oy = 60;
+    uint8_t bigBitmap[300];
+    const GFXglyph bigGlyph[] = { { 0, 40, 60, 42, 1, -50 } }; //too big for the rotation cache
+    const GFXfont bigFont = { bigBitmap, (GFXglyph*)bigGlyph, '#', '#', 64, NULL, 0, NULL, NULL, NULL };
+    const GFXfont* fonts[] = { &FreeSans9pt7b, &bigFont };
+    const char* strings[] = { "Ag|j", "#" };
+
+    srand(2);
+    for(size_t i=0; i < sizeof(bigBitmap); i++)
+      bigBitmap[i] = rand();
+
+    for(int f=0; f < 2; f++)
+    {
+      for(int style=0; style < 4; style++)
+      {
+        mono_gfx_init_buffered(&upright, 160,160);
+        upright.mFont = fonts[f];
+        upright.mTextStyle = style;
+        upright.mTextScale = ((style == 3) && (f == 0)) ? 2 : 1;
+        mono_gfx_print(&upright, ox, oy, strings[f], 1);
+
+        for(int rot = MONO_GFX_ROTATE_90; rot <= MONO_GFX_ROTATE_270; rot++)
+        {
+          mono_gfx_init_buffered(&rotated, 160,160);
+          mono_gfx_init_buffered(&ref, 160,160);
+          rotated.mFont = fonts[f];
+          rotated.mTextStyle = style;
+          rotated.mTextScale = upright.mTextScale;
+          rotated.mTextRotation = rot;
+          mono_gfx_print(&rotated, 80, 80, strings[f], 1);
+
+          //again through the cache, twice so the second print is served from it
+          mono_gfx_init_buffered(&cached, 160,160);
+          cached.mFont = fonts[f];
+          cached.mTextStyle = style;
+          cached.mTextScale = upright.mTextScale;
+          cached.mTextRotation = rot;
+          cached.mRotCache = &rotCache;
+          mono_gfx_print(&cached, 80, 80, strings[f], 1);
+          mono_gfx_fill(&cached, 0);
+          mono_gfx_print(&cached, 80, 80, strings[f], 1);
+
+          for(int py=0; py < 160; py++)
+          {
+            for(int px=0; px < 160; px++)
+            {
+              int i = py*160 + px;
+              if(!(upright.mBuffer[i/8] & (0x80 >> (i%8))))
+                continue;
+              int u = px - ox;
+              int v = py - oy;
+              if(rot == MONO_GFX_ROTATE_90)
+                mono_gfx_write_pixel(&ref, 80 - v, 80 + u, 1);
+              else if(rot == MONO_GFX_ROTATE_180)
+                mono_gfx_write_pixel(&ref, 80 - u, 80 - v, 1);
+              else
+                mono_gfx_write_pixel(&ref, 80 + v, 80 - u, 1);
+            }
+          }
+
+          for(uint32_t i=0; i < ref.mBufferSize; i++)
+          {
+            ASSERT_EQ(ref.mBuffer[i], rotated.mBuffer[i]) << "font " << f << " style " << style << " rotation " << rot << " failed at index:" << i ;
+            ASSERT_EQ(ref.mBuffer[i], cached.mBuffer[i]) << "cached font " << f << " style " << style << " rotation " << rot << " failed at index:" << i ;
+          }
+
+          mono_gfx_flush_glyph_cache(&cached);
+          mono_gfx_deinit(&cached);
+          mono_gfx_deinit(&rotated);
+          mono_gfx_deinit(&ref);
+        }
+        mono_gfx_deinit(&upright);
+      }
+    }
+}
+
+//Test that a prepared run draws the same as print
+TEST(MonoGfxTest, textRunTest)
+{
+    mono_gfx_t ref;
+    GFXrunItem items[16];
+    GFXrun run = { NULL, items, 16, 0, {0, 0, 0, 0} };
+
+    mono_gfx_init_buffered(&canvas, 128,32);
+    mono_gfx_init_buffered(&ref, 128,32);
+    canvas.mFont = &FreeSans9pt7b;
+    ref.mFont = &FreeSans9pt7b;
+
+    ASSERT_EQ(MRT_STATUS_OK, mono_gfx_prepare_text(&canvas, "Menu\nItem", &run));
+    ASSERT_EQ(8, run.count);
+    mono_gfx_draw_run(&canvas, 5, 12, &run, 1);
+    mono_gfx_print(&ref, 5, 12, "Menu\nItem", 1);
+
+    for(uint32_t i=0; i < canvas.mBufferSize; i++)
+    {
+      ASSERT_EQ(ref.mBuffer[i], canvas.mBuffer[i]) << "failed at index:" << i ;
+    }
+
+    //bounds should just cover the ink
+    for(int py=0; py < 32; py++)
+    {
+      for(int px=0; px < 128; px++)
+      {
+        int i = py*128 + px;
+        bool inside = (px >= 5 + run.bounds.x) && (px < 5 + run.bounds.x + run.bounds.w) && (py >= 12 + run.bounds.y) && (py < 12 + run.bounds.y + run.bounds.h);
+        if(canvas.mBuffer[i/8] & (0x80 >> (i%8)))
+        {
+          ASSERT_TRUE(inside) << px << "," << py;
+        }
+      }
+    }
+    ASSERT_EQ(-12, run.bounds.y); //top of 'M' and 'I'
+
+    //too small
+    run.capacity = 4;
+    ASSERT_EQ(MRT_STATUS_ERROR, mono_gfx_prepare_text(&canvas, "Menu\nItem", &run));
+    ASSERT_EQ(4, run.count);
+
+    mono_gfx_deinit(&canvas);
+    mono_gfx_deinit(&ref);
+}
+
+//Test printing through the string cache, including eviction
+TEST(MonoGfxTest, textCacheTest)
+{
+    mono_gfx_t ref;
+    mono_gfx_text_cache_t cache;
+    const char* labels[] = { "LOT 1234", "EXP 2027", "LOT 1234", "Qty: 50", "LOT 1234", "EXP 2027" };
+    const uint32_t budgets[] = { 450, 300 }; //all three labels fit, only two fit
+
+    for(int b=0; b < 2; b++)
+    {
+      ASSERT_EQ(MRT_STATUS_OK, mono_gfx_text_cache_init(&cache, budgets[b], 4));
+      mono_gfx_init_buffered(&canvas, 96,24);
+      mono_gfx_init_buffered(&ref, 96,24);
+      canvas.mFont = &FreeSans9pt7b;
+      ref.mFont = &FreeSans9pt7b;
+      canvas.mTextCache = &cache;
+
+      for(int l=0; l < 6; l++)
+      {
+        mono_gfx_fill(&canvas, 0);
+        mono_gfx_fill(&ref, 0);
+        mono_gfx_print(&canvas, 3, 16, labels[l], 1);
+        mono_gfx_print(&ref, 3, 16, labels[l], 1);
+
+        for(uint32_t i=0; i < canvas.mBufferSize; i++)
+        {
+          ASSERT_EQ(ref.mBuffer[i], canvas.mBuffer[i]) << "budget " << budgets[b] << " label " << l << " failed at index:" << i ;
+        }
+      }
+
+      if(b == 0)
+      {
+        ASSERT_EQ(3u, cache.mMisses);
+        ASSERT_EQ(3u, cache.mHits);
+        ASSERT_EQ(0u, cache.mEvictions);
+      }
+      else
+      {
+        ASSERT_GT(cache.mEvictions, 0u);
+      }
+
+      //flushing the canvas before a font is unloaded empties the cache
+      mono_gfx_flush_glyph_cache(&canvas);
+      uint32_t misses = cache.mMisses;
+      mono_gfx_print(&canvas, 3, 16, labels[0], 1);
+      ASSERT_EQ(misses + 1, cache.mMisses);
+
+      mono_gfx_deinit(&canvas);
+      mono_gfx_deinit(&ref);
+      mono_gfx_text_cache_deinit(&cache);
+    }
+
+    //strings longer than 64k are stored and matched whole
+    std::string longText(0x10001, ' ');
+    longText[0] = 'A';
+    ASSERT_EQ(MRT_STATUS_OK, mono_gfx_text_cache_init(&cache, 0x11000, 4));
+    mono_gfx_init_buffered(&canvas, 96,24);
+    canvas.mFont = &FreeSans9pt7b;
+    canvas.mTextCache = &cache;
+    mono_gfx_print(&canvas, 3, 16, longText.c_str(), 1);
+    mono_gfx_print(&canvas, 3, 16, "A", 1);
+    mono_gfx_print(&canvas, 3, 16, longText.c_str(), 1);
+    ASSERT_EQ(2u, cache.mMisses);
+    ASSERT_EQ(1u, cache.mHits);
+    uint32_t longest = 0;
+    for(int i=0; i < cache.mEntryCount; i++)
+    {
+      if(cache.mEntries[i].mSeq && (cache.mEntries[i].mTextLen > longest))
+        longest = cache.mEntries[i].mTextLen;
+    }
+    ASSERT_EQ(0x10001u, longest);
+    mono_gfx_deinit(&canvas);
+    mono_gfx_text_cache_deinit(&cache);
+}
+
+//Test the row by row path for fixed advance fonts against drawing each glyph
+TEST(MonoGfxTest, fixedAdvanceTest)
+{
+    mono_gfx_t ref;
+    const char* text = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz!@#$%^&*()\nTemp: -12.5 C";
+
+    ASSERT_EQ(11, mono_gfx_fixed_advance(&FreeMono9pt7b));
+    ASSERT_EQ(0, mono_gfx_fixed_advance(&FreeSans9pt7b));
+    ASSERT_EQ(0, mono_gfx_fixed_advance(&testFontKerned));
+
+    //the result is kept in the font cache
+    GFXfontCache monoCache = {}, sansCache = {};
+    GFXfont monoFont = FreeMono9pt7b, sansFont = FreeSans9pt7b;
+    monoFont.cache = &monoCache;
+    sansFont.cache = &sansCache;
+    ASSERT_EQ(11, mono_gfx_fixed_advance(&monoFont));
+    ASSERT_EQ(0, mono_gfx_fixed_advance(&sansFont));
+    ASSERT_TRUE((monoCache.flags & MONO_GFX_FONT_CACHE_ADVANCE) && (sansCache.flags & MONO_GFX_FONT_CACHE_ADVANCE));
+    ASSERT_EQ(11, monoCache.fixedAdvance);
+    ASSERT_EQ(11, mono_gfx_fixed_advance(&monoFont));
+
+    mono_gfx_init_buffered(&canvas, 200,40);
+    mono_gfx_init_buffered(&ref, 200,40);
+    canvas.mFont = &FreeMono9pt7b;
+
+    //first line is longer than a batch and runs off the right side
+    mono_gfx_print(&canvas, -3, 10, text, 1);
+
+    int x = -3;
+    int y = 10;
+    for(const char* c = text; *c; c++)
+    {
+      if(*c == '\n')
+      {
+        x = -3;
+        y += FreeMono9pt7b.yAdvance;
+        continue;
+      }
+      mono_gfx_draw_glyph(&ref, &FreeMono9pt7b, &FreeMono9pt7b.glyph[*c - FreeMono9pt7b.first], x, y, 1);
+      x += 11;
+    }
+
+    for(uint32_t i=0; i < canvas.mBufferSize; i++)
+    {
+      ASSERT_EQ(ref.mBuffer[i], canvas.mBuffer[i]) << "failed at index:" << i ;
+    }
+
+    mono_gfx_deinit(&canvas);
+    mono_gfx_deinit(&ref);
+}
+
+//Test that the pen advances by xAdvance alone, with xOffset only placing the glyph (as in Adafruit GFX)
+TEST(MonoGfxTest, glyphAdvanceTest)
+{
+    const GFXglyph offsetGlyphs[] = {
+      { 0, 2, 2, 5, 2, -2 }, // 0x41 'A'
+      { 0, 2, 2, 3, 1, -2 }  // 0x42 'B'
+    };
+    const GFXfont offsetFont = { (uint8_t*)testFontBitmaps, (GFXglyph*)offsetGlyphs, 0x41, 0x42, 4, NULL, 0, NULL, NULL, NULL };
+    GFXrect bounds;
+
+    mono_gfx_init_buffered(&canvas, 16,2);
+    canvas.mFont = &offsetFont;
+
+    //proportional, through the cursor. 'A' at 2..3, 'B' at pen 5 + 1
+    mono_gfx_print(&canvas, 0, 2, "AB", 1);
+    ASSERT_EQ(0x33, canvas.mBuffer[0]);
+    ASSERT_EQ(0x00, canvas.mBuffer[1]);
+    mono_gfx_text_bounds(&canvas, "AB", &bounds);
+    ASSERT_EQ(2, bounds.x);
+    ASSERT_EQ(6, bounds.w);
+
+    //with only 'A' the font is fixed advance, and the row by row path places glyphs the same way
+    const GFXfont fixedFont = { (uint8_t*)testFontBitmaps, (GFXglyph*)offsetGlyphs, 0x41, 0x41, 4, NULL, 0, NULL, NULL, NULL };
+    ASSERT_EQ(5, mono_gfx_fixed_advance(&fixedFont));
+    canvas.mFont = &fixedFont;
+    mono_gfx_fill(&canvas, 0);
+    mono_gfx_print(&canvas, 0, 2, "AA", 1);
+    ASSERT_EQ(0x31, canvas.mBuffer[0]);
+    ASSERT_EQ(0x80, canvas.mBuffer[1]);
+
+    mono_gfx_deinit(&canvas);
+}
+
+//Test the terminal, scrolling with the whole block copy, the byte aligned row copy, and the bit by bit copy
+TEST(MonoGfxTest, termTest)
+{
+    mono_gfx_t ref;
+    mono_gfx_term_t term;
+    const int setups[3][3] = { { 88, 0, 0 }, { 100, 3, 2 }, { 99, 3, 2 } }; //canvas width, terminal x, terminal y
+
+    for(int s=0; s < 3; s++)
+    {
+      int x = setups[s][1];
+      int y = setups[s][2];
+
+      mono_gfx_init_buffered(&canvas, setups[s][0],40);
+      mono_gfx_init_buffered(&ref, setups[s][0],40);
+      ref.mFont = &FreeMono9pt7b;
+
+      ASSERT_EQ(MRT_STATUS_ERROR, mono_gfx_term_init(&term, &canvas, &FreeSans9pt7b, x, y, 88, 36));
+      ASSERT_EQ(MRT_STATUS_OK, mono_gfx_term_init(&term, &canvas, &FreeMono9pt7b, x, y, 88, 36));
+      ASSERT_EQ(8, term.mCols);
+      ASSERT_EQ(2, term.mRows);
+
+      mono_gfx_term_write(&term, "AB\nCD");
+      ASSERT_EQ(4, mono_gfx_term_render(&term));
+
+      //third line scrolls the first one off
+      mono_gfx_term_write(&term, "\nEF");
+      ASSERT_EQ(2, mono_gfx_term_render(&term));
+      mono_gfx_print(&ref, x, y + term.mAscent, "CD\nEF", 1);
+
+      for(uint32_t i=0; i < canvas.mBufferSize; i++)
+      {
+        ASSERT_EQ(ref.mBuffer[i], canvas.mBuffer[i]) << "setup " << s << " failed at index:" << i ;
+      }
+
+      //only the cell that changes is drawn
+      mono_gfx_term_write(&term, "\rEX");
+      ASSERT_EQ(1, mono_gfx_term_render(&term));
+      ASSERT_EQ(0, mono_gfx_term_render(&term));
+
+      mono_gfx_deinit(&canvas);
+      mono_gfx_deinit(&ref);
+    }
+}
+
+//Test number printing against printing the same text
+TEST(MonoGfxTest, printNumberTest)
+{
+    mono_gfx_t ref;
+    int digit = FreeSans9pt7b.glyph['0' - FreeSans9pt7b.first].xAdvance;
+
+    mono_gfx_init_buffered(&canvas, 128,24);
+    mono_gfx_init_buffered(&ref, 128,24);
+    canvas.mFont = &FreeSans9pt7b;
+    ref.mFont = &FreeSans9pt7b;
+
+    struct { int32_t value; int decimals; int width; uint8_t flags; const char* text; int pad; } cases[] = {
+      { -42, 0, 6, MONO_GFX_NUM_ZERO_PAD, "-00042", 0 },
+      { 1234, 2, 0, 0, "12.34", 0 },
+      { -5, 2, 0, 0, "-0.05", 0 },
+      { 7, 1, 5, MONO_GFX_NUM_SHOW_PLUS, "+0.7", 1 },
+      { 42, 0, 5, 0, "42", 3 },
+      { INT32_MIN, 0, 0, 0, "-2147483648", 0 },
+    };
+
+    for(size_t c=0; c < sizeof(cases) / sizeof(cases[0]); c++)
+    {
+      mono_gfx_fill(&canvas, 0);
+      mono_gfx_fill(&ref, 0);
+      ASSERT_EQ(MRT_STATUS_OK, mono_gfx_print_fixed(&canvas, 2, 16, cases[c].value, cases[c].decimals, cases[c].width, cases[c].flags, 1));
+      mono_gfx_print(&ref, 2 + (cases[c].pad * digit), 16, cases[c].text, 1);
+
+      for(uint32_t i=0; i < canvas.mBufferSize; i++)
+      {
+        ASSERT_EQ(ref.mBuffer[i], canvas.mBuffer[i]) << cases[c].text << " failed at index:" << i ;
+      }
+    }
+
+    //a font with a cache keeps its digit glyphs, even when other fonts are used in between
+    GFXfontCache fontCache = {};
+    GFXfont cachedFont = FreeSans9pt7b;
+    cachedFont.cache = &fontCache;
+
+    for(size_t c=0; c < sizeof(cases) / sizeof(cases[0]); c++)
+    {
+      mono_gfx_fill(&canvas, 0);
+      mono_gfx_fill(&ref, 0);
+      canvas.mFont = &FreeMono9pt7b;
+      mono_gfx_print_int(&canvas, 2, 16, c, 0, 0, 0);
+      canvas.mFont = &cachedFont;
+      ASSERT_EQ(MRT_STATUS_OK, mono_gfx_print_fixed(&canvas, 2, 16, cases[c].value, cases[c].decimals, cases[c].width, cases[c].flags, 1));
+      ASSERT_TRUE(fontCache.flags & MONO_GFX_FONT_CACHE_DIGITS);
+      ASSERT_EQ(&FreeSans9pt7b.glyph['7' - FreeSans9pt7b.first], fontCache.digits[7]);
+      mono_gfx_print(&ref, 2 + (cases[c].pad * digit), 16, cases[c].text, 1);
+
+      for(uint32_t i=0; i < canvas.mBufferSize; i++)
+      {
+        ASSERT_EQ(ref.mBuffer[i], canvas.mBuffer[i]) << "cached " << cases[c].text << " failed at index:" << i ;
+      }
+    }
+
+    ASSERT_EQ(MRT_STATUS_ERROR, mono_gfx_print_fixed(&canvas, 0, 16, 1, 11, 0, 0, 1));
+
+    mono_gfx_deinit(&canvas);
+    mono_gfx_deinit(&ref);
+}
+
+//Test falling back to a second font for characters the canvas font does not have
+TEST(MonoGfxTest, fontChainTest)
+{
+    mono_gfx_t ref;
+    GFXfontChain chain;
+    const GFXfont* fallbacks[] = { &testFont };
+    const GFXglyph* H = &FreeSans9pt7b.glyph['H' - FreeSans9pt7b.first];
+    const GFXglyph* i = &FreeSans9pt7b.glyph['i' - FreeSans9pt7b.first];
+    const GFXglyph* snowman = mono_gfx_get_glyph(&testFont, 0x2603);
+    int w, h;
+
+    mono_gfx_font_chain_init(&chain, fallbacks, 1);
+    mono_gfx_init_buffered(&canvas, 64,24);
+    mono_gfx_init_buffered(&ref, 64,24);
+    canvas.mFont = &FreeSans9pt7b;
+    canvas.mFontChain = &chain;
+
+    //snowman only exists in the fallback font
+    mono_gfx_print(&canvas, 2, 16, "Hi\xE2\x98\x83", 1);
+    mono_gfx_draw_glyph(&ref, &FreeSans9pt7b, H, 2, 16, 1);
+    mono_gfx_draw_glyph(&ref, &FreeSans9pt7b, i, 2 + H->xAdvance, 16, 1);
+    mono_gfx_draw_glyph(&ref, &testFont, snowman, 2 + H->xAdvance + i->xAdvance, 16, 1);
+
+    for(uint32_t n=0; n < canvas.mBufferSize; n++)
+    {
+      ASSERT_EQ(ref.mBuffer[n], canvas.mBuffer[n]) << "failed at index:" << n ;
+    }
+
+    mono_gfx_measure(&canvas, "Hi\xE2\x98\x83", &w, &h);
+    ASSERT_EQ(H->xAdvance + i->xAdvance + snowman->xAdvance, w);
+
+    //measure and the second print are answered from the cache
+    uint32_t misses = chain.misses;
+    mono_gfx_print(&canvas, 2, 16, "Hi\xE2\x98\x83", 1);
+    ASSERT_EQ(misses, chain.misses);
+    ASSERT_EQ(6u, chain.hits);
+
+    mono_gfx_deinit(&canvas);
+    mono_gfx_deinit(&ref);
+}
+
+static bool getPixel(mono_gfx_t* gfx, int x, int y)
+{
+    if((x < 0) || (x >= gfx->mWidth) || (y < 0) || (y >= gfx->mHeight))
+        return false;
+
+    int i = (y * gfx->mWidth) + x;
+    return (gfx->mBuffer[i/8] & (0x80 >> (i%8))) != 0;
+}
+
+static int spanCalls = 0;
+static mrt_status_t countSpan(mono_gfx_t* gfx, int x0, int x1, int y, uint8_t val)
+{
+    (void)gfx; (void)x0; (void)x1; (void)y; (void)val;
+    spanCalls++;
+    return MRT_STATUS_OK;
+}
+
+//Test circles, ellipses, and rounded rects against testing every pixel
+TEST(MonoGfxTest, shapeTest)
+{
+    mono_gfx_t outline;
+    mono_gfx_t inverted;
+    mono_gfx_t unbuffered;
+    const int cx = 30, cy = 22;
+
+    mono_gfx_init_buffered(&canvas, 64,48);
+    mono_gfx_init_buffered(&outline, 64,48);
+    mono_gfx_init_buffered(&inverted, 64,48);
+
+    //shape 0 is an ellipse, shape 1 is a rounded rect
+    for(int shape=0; shape < 2; shape++)
+    {
+      for(int rx=0; rx < 14; rx++)
+      {
+        int ry = (rx * 2 + 3) % 17;
+        int x = 4, y = 3, w = 2*rx + 5, h = ry + 9, r = ry / 2;
+
+        mono_gfx_fill(&canvas, 0);
+        mono_gfx_fill(&outline, 0);
+        mono_gfx_fill(&inverted, 0);
+
+        if(shape == 0)
+        {
+          mono_gfx_fill_ellipse(&canvas, cx, cy, rx, ry, 1);
+          mono_gfx_draw_ellipse(&outline, cx, cy, rx, ry, 1);
+          mono_gfx_draw_ellipse(&inverted, cx, cy, rx, ry, 2);
+        }
+        else
+        {
+          mono_gfx_fill_round_rect(&canvas, x, y, w, h, r, 1);
+          mono_gfx_draw_round_rect(&outline, x, y, w, h, r, 1);
+          mono_gfx_draw_round_rect(&inverted, x, y, w, h, r, 2);
+        }
+
+        for(int py=0; py < 48; py++)
+        {
+          for(int px=0; px < 64; px++)
+          {
+            bool inside;
+            if(shape == 0)
+            {
+              int64_t dx = px - cx, dy = py - cy, W = 2*rx + 1, H = 2*ry + 1;
+              inside = (4*dx*dx*H*H + 4*dy*dy*W*W) <= (W*W*H*H);
+            }
+            else
+            {
+              //distance into the corner region from the corner circle center
+              int ccx = (px < x + r) ? x + r : (px > x + w - 1 - r) ? x + w - 1 - r : px;
+              int ccy = (py < y + r) ? y + r : (py > y + h - 1 - r) ? y + h - 1 - r : py;
+              int dx = px - ccx, dy = py - ccy;
+              inside = (px >= x) && (px < x + w) && (py >= y) && (py < y + h) && (dx*dx + dy*dy <= r*r + r);
+            }
+            ASSERT_EQ(inside, getPixel(&canvas, px, py)) << "shape " << shape << " rx " << rx << " at " << px << "," << py;
+
+            //outline is the edge of the fill, and no pixel of it is drawn twice
+            bool edge = inside && (!getPixel(&canvas, px-1, py) || !getPixel(&canvas, px+1, py) || !getPixel(&canvas, px, py-1) || !getPixel(&canvas, px, py+1));
+            if(edge)
+            {
+              ASSERT_TRUE(getPixel(&outline, px, py)) << "shape " << shape << " rx " << rx << " missing edge at " << px << "," << py;
+            }
+            if(getPixel(&outline, px, py))
+            {
+              ASSERT_TRUE(inside) << "shape " << shape << " rx " << rx << " outline outside at " << px << "," << py;
+            }
+            ASSERT_EQ(getPixel(&outline, px, py), getPixel(&inverted, px, py)) << "shape " << shape << " rx " << rx << " double draw at " << px << "," << py;
+          }
+        }
+      }
+    }
+
+    //radii up to the limit, with only an edge of the shape on the canvas
+    const int big[4][4] = {
+      { 32, 24 + 16383 - 10, 16383, 16383 },
+      { -16000, 20, 16040, 30 },
+      { 32 + 8485, 24 - 6364, 12000, 9000 },
+      { 32, -5, 16383, 10 }
+    };
+    for(int n=0; n < 4; n++)
+    {
+      int bx = big[n][0], by = big[n][1], rx = big[n][2], ry = big[n][3];
+      int64_t W = 2*(int64_t)rx + 1, H = 2*(int64_t)ry + 1;
+      int set = 0;
+
+      mono_gfx_fill(&canvas, 0);
+      mono_gfx_fill(&outline, 0);
+      mono_gfx_fill(&inverted, 0);
+      ASSERT_EQ(MRT_STATUS_OK, mono_gfx_fill_ellipse(&canvas, bx, by, rx, ry, 1));
+      ASSERT_EQ(MRT_STATUS_OK, mono_gfx_draw_ellipse(&outline, bx, by, rx, ry, 1));
+      ASSERT_EQ(MRT_STATUS_OK, mono_gfx_draw_ellipse(&inverted, bx, by, rx, ry, 2));
+
+      for(int py=0; py < 48; py++)
+      {
+        for(int px=0; px < 64; px++)
+        {
+          int64_t dx = px - bx, dy = py - by;
+          bool inside = (4*dx*dx*H*H + 4*dy*dy*W*W) <= (W*W*H*H);
+          ASSERT_EQ(inside, getPixel(&canvas, px, py)) << "big " << n << " at " << px << "," << py;
+          if(getPixel(&outline, px, py))
+          {
+            ASSERT_TRUE(inside) << "big " << n << " outline outside at " << px << "," << py;
+          }
+          ASSERT_EQ(getPixel(&outline, px, py), getPixel(&inverted, px, py)) << "big " << n << " double draw at " << px << "," << py;
+          set += inside;
+        }
+      }
+      ASSERT_GT(set, 0) << "big " << n;
+    }
+    ASSERT_EQ(MRT_STATUS_ERROR, mono_gfx_fill_circle(&canvas, cx, cy, MONO_GFX_ROUND_LIMIT + 1, 1));
+    ASSERT_EQ(MRT_STATUS_ERROR, mono_gfx_draw_ellipse(&canvas, cx, cy, 5, 10000000, 1));
+    ASSERT_EQ(MRT_STATUS_ERROR, mono_gfx_fill_round_rect(&canvas, 0, 0, 100000, 100000, 50000, 1));
+
+    //rounded rects far taller than the canvas, and ones whose bottom is past INT_MAX
+    mono_gfx_fill(&canvas, 0);
+    mono_gfx_fill(&outline, 0);
+    ASSERT_EQ(MRT_STATUS_OK, mono_gfx_fill_round_rect(&canvas, 5, -1000000000, 20, 2000000000, 6, 1));
+    ASSERT_EQ(MRT_STATUS_OK, mono_gfx_fill_round_rect(&canvas, 40, 10, 9, INT_MAX, 4, 1));
+    mono_gfx_fill_round_rect(&outline, 5, -100, 20, 300, 6, 1);
+    mono_gfx_fill_round_rect(&outline, 40, 10, 9, 100, 4, 1);
+    ASSERT_EQ(0, memcmp(canvas.mBuffer, outline.mBuffer, canvas.mBufferSize));
+
+    //fills go to the span callback one row at a time, and only rows on the canvas are walked
+    mono_gfx_init_unbuffered(&unbuffered, 64, 48, NULL, NULL);
+    unbuffered.fWriteSpan = &countSpan;
+    mono_gfx_fill_circle(&unbuffered, cx, cy, 10, 1);
+    ASSERT_EQ(21, spanCalls);
+    spanCalls = 0;
+    mono_gfx_fill_circle(&unbuffered, cx, cy, MONO_GFX_ROUND_LIMIT, 1);
+    ASSERT_EQ(48, spanCalls);
+
+    mono_gfx_deinit(&canvas);
+    mono_gfx_deinit(&outline);
+    mono_gfx_deinit(&inverted);
+}
+
+//per pixel reference versions of the shape primitives, used by shapeBenchmark
+
+//Adafruit style 8 way midpoint circle
+static void refDrawCircle(mono_gfx_t* gfx, int x0, int y0, int r, uint8_t val)
+{
+    int f = 1 - r, ddx = 1, ddy = -2 * r, x = 0, y = r;
+
+    mono_gfx_write_pixel(gfx, x0, y0 + r, val);
+    mono_gfx_write_pixel(gfx, x0, y0 - r, val);
+    mono_gfx_write_pixel(gfx, x0 + r, y0, val);
+    mono_gfx_write_pixel(gfx, x0 - r, y0, val);
+    while(x < y)
+    {
+      if(f >= 0)
+      {
+        y--;
+        ddy += 2;
+        f += ddy;
+      }
+      x++;
+      ddx += 2;
+      f += ddx;
+      mono_gfx_write_pixel(gfx, x0 + x, y0 + y, val);
+      mono_gfx_write_pixel(gfx, x0 - x, y0 + y, val);
+      mono_gfx_write_pixel(gfx, x0 + x, y0 - y, val);
+      mono_gfx_write_pixel(gfx, x0 - x, y0 - y, val);
+      mono_gfx_write_pixel(gfx, x0 + y, y0 + x, val);
+      mono_gfx_write_pixel(gfx, x0 - y, y0 + x, val);
+      mono_gfx_write_pixel(gfx, x0 + y, y0 - x, val);
+      mono_gfx_write_pixel(gfx, x0 - y, y0 - x, val);
+    }
+}
+
+//inside test for each pixel of the bounding box
+static void refFillEllipse(mono_gfx_t* gfx, int x0, int y0, int rx, int ry, uint8_t val)
+{
+    int64_t W = 2*rx + 1, H = 2*ry + 1;
+
+    for(int dy=-ry; dy <= ry; dy++)
+    {
+      for(int dx=-rx; dx <= rx; dx++)
+      {
+        if((4*dx*dx*H*H + 4*dy*dy*W*W) <= (W*W*H*H))
+          mono_gfx_write_pixel(gfx, x0 + dx, y0 + dy, val);
+      }
+    }
+}
+
+static void refFillRoundRect(mono_gfx_t* gfx, int x, int y, int w, int h, int r, uint8_t val)
+{
+    for(int py=y; py < y + h; py++)
+    {
+      for(int px=x; px < x + w; px++)
+      {
+        int ccx = (px < x + r) ? x + r : (px > x + w - 1 - r) ? x + w - 1 - r : px;
+        int ccy = (py < y + r) ? y + r : (py > y + h - 1 - r) ? y + h - 1 - r : py;
+        int dx = px - ccx, dy = py - ccy;
+        if(dx*dx + dy*dy <= r*r + r)
+          mono_gfx_write_pixel(gfx, px, py, val);
+      }
+    }
+}
+
+//average time of a call in us
+template<typename F> static double timeCall(F f, int n)
+{
+    auto start = std::chrono::steady_clock::now();
+    for(int i=0; i < n; i++)
+      f(i);
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / n;
+}
+
+//Times the shape primitives against the per pixel references. Disabled by default, run with:
+//  --gtest_also_run_disabled_tests --gtest_filter=*shapeBenchmark
+TEST(MonoGfxTest, DISABLED_shapeBenchmark)
+{
+    mono_gfx_t ref;
+    const int n = 20000;
+
+    mono_gfx_init_buffered(&canvas, 128,64);
+    mono_gfx_init_buffered(&ref, 128,64);
+
+    for(int r=4; r <= 16; r *= 2)
+    {
+      printf("fill_circle r=%-2d          %6.2f -> %.2f us\n", r,
+             timeCall([&](int i){ refFillEllipse(&ref, 64, 32, r, r, i & 1); }, n),
+             timeCall([&](int i){ mono_gfx_fill_circle(&canvas, 64, 32, r, i & 1); }, n));
+    }
+    printf("fill_ellipse 40x20        %6.2f -> %.2f us\n",
+           timeCall([&](int i){ refFillEllipse(&ref, 64, 32, 40, 20, i & 1); }, n),
+           timeCall([&](int i){ mono_gfx_fill_ellipse(&canvas, 64, 32, 40, 20, i & 1); }, n));
+    printf("fill_round_rect 100x40 r8 %6.2f -> %.2f us\n",
+           timeCall([&](int i){ refFillRoundRect(&ref, 10, 10, 100, 40, 8, i & 1); }, n),
+           timeCall([&](int i){ mono_gfx_fill_round_rect(&canvas, 10, 10, 100, 40, 8, i & 1); }, n));
+    printf("draw_circle r=16          %6.2f -> %.2f us\n",
+           timeCall([&](int i){ refDrawCircle(&ref, 64, 32, 16, i & 1); }, n),
+           timeCall([&](int i){ mono_gfx_draw_circle(&canvas, 64, 32, 16, i & 1); }, n));
+
+    //an even number of calls leaves both canvases clear, so the fills have to match the references
+    mono_gfx_fill_round_rect(&canvas, 10, 10, 100, 40, 8, 1);
+    refFillRoundRect(&ref, 10, 10, 100, 40, 8, 1);
+    for(uint32_t i=0; i < canvas.mBufferSize; i++)
+    {
+      ASSERT_EQ(ref.mBuffer[i], canvas.mBuffer[i]) << "failed at index:" << i ;
+    }
+
+    mono_gfx_deinit(&canvas);
+    mono_gfx_deinit(&ref);
+}
+
+//reference polygon test, counts crossings at or left of the pixel on edges that cover its row
+static bool insidePolygon(const GFXpoint* pts, int count, int px, int py, uint8_t rule)
+{
+    int crossings = 0;
+    int winding = 0;
+
+    for(int i=0; i < count; i++)
+    {
+        GFXpoint a = pts[i];
+        GFXpoint b = pts[(i + 1) % count];
+        int dir = 1;
+        if(a.y > b.y)
+        {
+            GFXpoint t = a; a = b; b = t;
+            dir = -1;
+        }
+        if((py < a.y) || (py >= b.y))
+            continue;
+
+        //corners can be any int, so the products can need more than 64 bits
+        int64_t dy = (int64_t)b.y - a.y;
+        if((__int128)((int64_t)px - a.x) * dy >= (__int128)((int64_t)py - a.y) * ((int64_t)b.x - a.x))
+        {
+            crossings++;
+            winding += dir;
+        }
+    }
+
+    return (rule == MONO_GFX_FILL_NON_ZERO) ? (winding != 0) : ((crossings & 1) != 0);
+}
+
+//Test polygon and triangle fills against testing every pixel
+TEST(MonoGfxTest, polygonTest)
+{
+    mono_gfx_t halves;
+    GFXpoint pts[12];
+    uint32_t seed = 1234;
+
+    mono_gfx_init_buffered(&canvas, 61,40);
+    mono_gfx_init_buffered(&halves, 61,40);
+
+    for(int n=0; n < 200; n++)
+    {
+        int count = 3 + (n % 10);
+        uint8_t rule = (n / 10) % 2;
+
+        //corners spread past the edges of the canvas to check clipping
+        for(int i=0; i < count; i++)
+        {
+            seed = seed * 1103515245 + 12345;
+            pts[i].x = (int)((seed >> 8) % 91) - 15;
+            seed = seed * 1103515245 + 12345;
+            pts[i].y = (int)((seed >> 8) % 70) - 15;
+        }
+
+        mono_gfx_fill(&canvas, 0);
+        ASSERT_EQ(MRT_STATUS_OK, mono_gfx_fill_polygon(&canvas, pts, count, rule, 2));
+
+        for(int py=0; py < 40; py++)
+            for(int px=0; px < 61; px++)
+                ASSERT_EQ(insidePolygon(pts, count, px, py, rule), getPixel(&canvas, px, py)) << "polygon " << n << " at " << px << "," << py;
+    }
+
+    //pentagram, the middle is only filled with the non zero rule
+    GFXpoint star[5] = {{30,2},{42,36},{12,14},{48,14},{18,36}};
+    mono_gfx_fill(&canvas, 0);
+    mono_gfx_fill_polygon(&canvas, star, 5, MONO_GFX_FILL_EVEN_ODD, 1);
+    ASSERT_FALSE(getPixel(&canvas, 30, 20));
+    ASSERT_TRUE(getPixel(&canvas, 30, 5));
+    mono_gfx_fill_polygon(&canvas, star, 5, MONO_GFX_FILL_NON_ZERO, 1);
+    ASSERT_TRUE(getPixel(&canvas, 30, 20));
+
+    //a rect from (3,4) to (13,9) fills 10x5 pixels, and the two triangles that make it up do not overlap
+    GFXpoint rect[4] = {{3,4},{13,4},{13,9},{3,9}};
+    mono_gfx_fill(&canvas, 0);
+    mono_gfx_fill(&halves, 0);
+    mono_gfx_fill_polygon(&canvas, rect, 4, MONO_GFX_FILL_EVEN_ODD, 1);
+    mono_gfx_draw_rect(&halves, 3, 4, 10, 5, 2);
+    ASSERT_EQ(0, memcmp(canvas.mBuffer, halves.mBuffer, canvas.mBufferSize));
+
+    mono_gfx_fill(&halves, 0);
+    mono_gfx_fill_triangle(&halves, 3,4, 13,4, 13,9, 2);
+    mono_gfx_fill_triangle(&halves, 3,4, 13,9, 3,9, 2);
+    ASSERT_EQ(0, memcmp(canvas.mBuffer, halves.mBuffer, canvas.mBufferSize));
+
+    //corners far off the canvas, more than INT_MAX apart
+    const GFXpoint far[3][4] = {
+      {{-2000000000,0}, {2000000000,10}, {0,40}, {0,40}},
+      {{INT_MAX,INT_MAX}, {INT_MIN,5}, {20,INT_MIN}, {20,INT_MIN}},
+      {{INT_MIN,INT_MIN}, {INT_MAX,-5}, {50,INT_MAX}, {-3,20}}
+    };
+    for(int n=0; n < 3; n++)
+    {
+        int count = (n < 2) ? 3 : 4;
+        int set = 0;
+
+        mono_gfx_fill(&canvas, 0);
+        if(n == 1)
+            mono_gfx_fill_triangle(&canvas, far[n][0].x, far[n][0].y, far[n][1].x, far[n][1].y, far[n][2].x, far[n][2].y, 1);
+        else
+            ASSERT_EQ(MRT_STATUS_OK, mono_gfx_fill_polygon(&canvas, far[n], count, MONO_GFX_FILL_NON_ZERO, 1));
+
+        for(int py=0; py < 40; py++)
+            for(int px=0; px < 61; px++)
+            {
+                ASSERT_EQ(insidePolygon(far[n], count, px, py, MONO_GFX_FILL_NON_ZERO), getPixel(&canvas, px, py)) << "far polygon " << n << " at " << px << "," << py;
+                set += getPixel(&canvas, px, py);
+            }
+        ASSERT_GT(set, 0) << "far polygon " << n;
+    }
+
+    GFXpoint many[MONO_GFX_POLY_MAX_EDGES + 1] = {};
+    ASSERT_EQ(MRT_STATUS_ERROR, mono_gfx_fill_polygon(&canvas, many, MONO_GFX_POLY_MAX_EDGES + 1, MONO_GFX_FILL_EVEN_ODD, 1));
+
+    mono_gfx_deinit(&canvas);
+    mono_gfx_deinit(&halves);
+}
+
+//Test thick and dashed lines
+TEST(MonoGfxTest, lineStyleTest)
+{
+    mono_gfx_t expected;
+    mono_gfx_t inverted;
+    mono_gfx_t unbuffered;
+
+    mono_gfx_init_buffered(&canvas, 67,50);
+    mono_gfx_init_buffered(&expected, 67,50);
+    mono_gfx_init_buffered(&inverted, 67,50);
+
+    //square caps run half the width past each end, butt caps stop at the ends
+    mono_gfx_fill(&canvas, 0);
+    mono_gfx_fill(&expected, 0);
+    mono_gfx_draw_line_thick(&canvas, 10,10, 30,10, 3, MONO_GFX_CAP_SQUARE, 1);
+    mono_gfx_draw_rect(&expected, 9, 9, 23, 3, 1);
+    ASSERT_EQ(0, memcmp(canvas.mBuffer, expected.mBuffer, canvas.mBufferSize));
+
+    mono_gfx_fill(&canvas, 0);
+    mono_gfx_fill(&expected, 0);
+    mono_gfx_draw_line_thick(&canvas, 10,40, 10,20, 4, MONO_GFX_CAP_BUTT, 1);
+    mono_gfx_draw_rect(&expected, 8, 20, 4, 20, 1);
+    ASSERT_EQ(0, memcmp(canvas.mBuffer, expected.mBuffer, canvas.mBufferSize));
+
+    //width 1 is a normal line
+    mono_gfx_fill(&canvas, 0);
+    mono_gfx_fill(&expected, 0);
+    mono_gfx_draw_line_thick(&canvas, 3,4, 60,33, 1, MONO_GFX_CAP_ROUND, 1);
+    mono_gfx_draw_line(&expected, 3,4, 60,33, 1);
+    ASSERT_EQ(0, memcmp(canvas.mBuffer, expected.mBuffer, canvas.mBufferSize));
+
+    //angled strokes cover the pixels near the line and nothing else, and no pixel is drawn twice
+    const int ends[4][4] = {{5,8, 60,40}, {50,3, 20,45}, {33,25, 33,25}, {8,40, 58,38}};
+    for(int n=0; n < 4; n++)
+    {
+        for(int width=2; width < 12; width += 3)
+        {
+            int x0 = ends[n][0], y0 = ends[n][1], x1 = ends[n][2], y1 = ends[n][3];
+            double half = width / 2.0;
+
+            mono_gfx_fill(&canvas, 0);
+            mono_gfx_fill(&inverted, 0);
+            mono_gfx_draw_line_thick(&canvas, x0,y0, x1,y1, width, MONO_GFX_CAP_ROUND, 1);
+            mono_gfx_draw_line_thick(&inverted, x0,y0, x1,y1, width, MONO_GFX_CAP_ROUND, 2);
+            ASSERT_EQ(0, memcmp(canvas.mBuffer, inverted.mBuffer, canvas.mBufferSize)) << "line " << n << " width " << width;
+
+            for(int py=0; py < 50; py++)
+            {
+                for(int px=0; px < 67; px++)
+                {
+                    //distance from the pixel to the nearest point on the segment
+                    double dx = x1 - x0, dy = y1 - y0;
+                    double len2 = dx*dx + dy*dy;
+                    double t = (len2 > 0) ? ((px - x0)*dx + (py - y0)*dy) / len2 : 0;
+                    t = (t < 0) ? 0 : (t > 1) ? 1 : t;
+                    double ex = px - (x0 + t*dx), ey = py - (y0 + t*dy);
+                    double dist = sqrt(ex*ex + ey*ey);
+
+                    if(dist < half - 0.6)
+                    {
+                        ASSERT_TRUE(getPixel(&canvas, px, py)) << "line " << n << " width " << width << " gap at " << px << "," << py;
+                    }
+                    if(dist > half + 0.6)
+                    {
+                        ASSERT_FALSE(getPixel(&canvas, px, py)) << "line " << n << " width " << width << " extra at " << px << "," << py;
+                    }
+                }
+            }
+        }
+    }
+
+    //end points far off the canvas draw the same stroke as nearby points on the same line
+    const int far[3][8] = {
+      { -200,-80, 200,120,  -(1 << 30), 20 - (1 << 29), 1 << 30, 20 + (1 << 29) },
+      { -100,-100, 100,100,  INT_MIN, INT_MIN, INT_MAX, INT_MAX },
+      { 30,-300, 30,300,  30, INT_MIN, 30, INT_MAX }
+    };
+    for(int n=0; n < 3; n++)
+    {
+        mono_gfx_fill(&canvas, 0);
+        mono_gfx_fill(&expected, 0);
+        ASSERT_EQ(MRT_STATUS_OK, mono_gfx_draw_line_thick(&canvas, far[n][4], far[n][5], far[n][6], far[n][7], 5, MONO_GFX_CAP_ROUND, 1));
+        mono_gfx_draw_line_thick(&expected, far[n][0], far[n][1], far[n][2], far[n][3], 5, MONO_GFX_CAP_ROUND, 1);
+        ASSERT_EQ(0, memcmp(canvas.mBuffer, expected.mBuffer, canvas.mBufferSize)) << "far line " << n;
+    }
+    ASSERT_EQ(MRT_STATUS_ERROR, mono_gfx_draw_line_thick(&canvas, 0,0, 10,10, 70000, MONO_GFX_CAP_BUTT, 1));
+
+    //a solid pattern is a normal line, in every direction
+    const int dirs[4][4] = {{2,2, 60,30}, {60,2, 2,47}, {30,48, 40,1}, {64,40, 1,38}};
+    for(int n=0; n < 4; n++)
+    {
+        mono_gfx_fill(&canvas, 0);
+        mono_gfx_fill(&expected, 0);
+        mono_gfx_draw_line_dashed(&canvas, dirs[n][0], dirs[n][1], dirs[n][2], dirs[n][3], 0xFFFFFFFF, 32, 1);
+        mono_gfx_draw_line(&expected, dirs[n][0], dirs[n][1], dirs[n][2], dirs[n][3], 1);
+
+        int a = 0, b = 0;
+        for(int py=0; py < 50; py++)
+            for(int px=0; px < 67; px++)
+            {
+                a += getPixel(&canvas, px, py);
+                b += getPixel(&expected, px, py);
+            }
+        ASSERT_EQ(b, a) << "line " << n;
+        if(n < 1)
+        {
+            ASSERT_EQ(0, memcmp(canvas.mBuffer, expected.mBuffer, canvas.mBufferSize));
+        }
+    }
+
+    //3 on 2 off, starting from p1
+    mono_gfx_fill(&canvas, 0);
+    mono_gfx_draw_line_dashed(&canvas, 40,5, 0,5, 0xE0000000, 5, 1);
+    for(int x=0; x <= 40; x++)
+        ASSERT_EQ(((40 - x) % 5) < 3, getPixel(&canvas, x, 5)) << x;
+
+    ASSERT_EQ(MRT_STATUS_ERROR, mono_gfx_draw_line_dashed(&canvas, 0,0, 9,9, 0xF0000000, 33, 1));
+
+    //dashes go to the span callback whole
+    mono_gfx_init_unbuffered(&unbuffered, 67, 50, NULL, NULL);
+    unbuffered.fWriteSpan = &countSpan;
+    spanCalls = 0;
+    mono_gfx_draw_line_dashed(&unbuffered, 0,5, 39,5, 0xF0000000, 8, 1);
+    ASSERT_EQ(5, spanCalls);
+
+    mono_gfx_deinit(&canvas);
+    mono_gfx_deinit(&expected);
+    mono_gfx_deinit(&inverted);
+}
+
+//unclipped Bresenham in 64 bits, for checking clipped lines
+static void referenceLine(mono_gfx_t* gfx, int64_t x0, int64_t y0, int64_t x1, int64_t y1, uint32_t pattern, int length)
+{
+    bool steep = llabs(y1 - y0) > llabs(x1 - x0);
+    int64_t major = steep ? llabs(y1 - y0) : llabs(x1 - x0);
+    int64_t minor = steep ? llabs(x1 - x0) : llabs(y1 - y0);
+    int64_t sx = (x0 < x1) ? 1 : -1, sy = (y0 < y1) ? 1 : -1;
+    int64_t err = major / 2;
+    int64_t x = x0, y = y0;
+
+    for(int64_t i=0; i <= major; i++)
+    {
+        if(((pattern << (i % length)) & 0x80000000) && (x >= 0) && (x < gfx->mWidth) && (y >= 0) && (y < gfx->mHeight))
+            mono_gfx_write_pixel(gfx, (int)x, (int)y, 1);
+
+        if(steep) y += sy; else x += sx;
+        err -= minor;
+        if(err < 0)
+        {
+            if(steep) x += sx; else y += sy;
+            err += major;
+        }
+    }
+}
+
+//Same pixels as referenceLine, but only the steps that land on the canvas are worked out, so lines can be billions of pixels long
+static void referenceFarLine(mono_gfx_t* gfx, int64_t x0, int64_t y0, int64_t x1, int64_t y1, uint32_t pattern, int length)
+{
+    bool steep = llabs(y1 - y0) > llabs(x1 - x0);
+    int64_t a0 = steep ? y0 : x0, b0 = steep ? x0 : y0;
+    int64_t sa = ((steep ? y1 : x1) > a0) ? 1 : -1, sb = ((steep ? x1 : y1) > b0) ? 1 : -1;
+    uint64_t major = steep ? llabs(y1 - y0) : llabs(x1 - x0);
+    uint64_t minor = steep ? llabs(x1 - x0) : llabs(y1 - y0);
+    int size = steep ? gfx->mHeight : gfx->mWidth;
+
+    for(int a=0; a < size; a++)
+    {
+        int64_t i = (a - a0) * sa;
+        if((i < 0) || ((uint64_t)i > major))
+            continue;
+
+        //minor steps taken after i steps, from an error term that starts at major / 2
+        uint64_t k = 0;
+        if((uint64_t)i * minor > major / 2)
+            k = (((uint64_t)i * minor) - (major / 2) + major - 1) / major;
+        int64_t b = b0 + (sb * (int64_t)k);
+
+        int x = steep ? (int)b : a, y = steep ? a : (int)b;
+        if(((pattern << (i % length)) & 0x80000000) && (b >= 0) && (x < gfx->mWidth) && (y < gfx->mHeight))
+            mono_gfx_write_pixel(gfx, x, y, 1);
+    }
+}
+
+static int pixelCalls = 0;
+static mrt_status_t countPixel(mono_gfx_t* gfx, int x, int y, uint8_t val)
+{
+    (void)gfx; (void)x; (void)y; (void)val;
+    pixelCalls++;
+    return MRT_STATUS_OK;
+}
+
+//Test that lines clipped to the canvas hit the same pixels as the full line
+TEST(MonoGfxTest, lineClipTest)
+{
+    mono_gfx_t expected;
+    mono_gfx_t unbuffered;
+    uint32_t seed = 99;
+
+    mono_gfx_init_buffered(&canvas, 45,30);
+    mono_gfx_init_buffered(&expected, 45,30);
+
+    for(int n=0; n < 2000; n++)
+    {
+        int range = (n < 1500) ? 160 : 200000;
+        int c[4];
+        for(int i=0; i < 4; i++)
+        {
+            seed = seed * 1103515245 + 12345;
+            c[i] = (int)((seed >> 4) % range) - (range / 2) + 20;
+        }
+
+        //mono_gfx_draw_line always steps from the left (or top) end
+        bool steep = abs(c[3] - c[1]) > abs(c[2] - c[0]);
+        bool flip = steep ? (c[1] > c[3]) : (c[0] > c[2]);
+
+        mono_gfx_fill(&canvas, 0);
+        mono_gfx_fill(&expected, 0);
+        mono_gfx_draw_line(&canvas, c[0], c[1], c[2], c[3], 1);
+        if(flip)
+            referenceLine(&expected, c[2], c[3], c[0], c[1], 0xFFFFFFFF, 32);
+        else
+            referenceLine(&expected, c[0], c[1], c[2], c[3], 0xFFFFFFFF, 32);
+        ASSERT_EQ(0, memcmp(canvas.mBuffer, expected.mBuffer, canvas.mBufferSize)) << "line " << c[0] << "," << c[1] << " " << c[2] << "," << c[3];
+
+        mono_gfx_fill(&canvas, 0);
+        mono_gfx_fill(&expected, 0);
+        mono_gfx_draw_line_dashed(&canvas, c[0], c[1], c[2], c[3], 0xE4000000, 7, 1);
+        referenceLine(&expected, c[0], c[1], c[2], c[3], 0xE4000000, 7);
+        ASSERT_EQ(0, memcmp(canvas.mBuffer, expected.mBuffer, canvas.mBufferSize)) << "dashed " << c[0] << "," << c[1] << " " << c[2] << "," << c[3];
+    }
+
+    //long lines whose error terms pass INT_MAX, and end points more than INT_MAX apart, drawn from both ends
+    const int64_t far[6][4] = {
+      { 0,0, 2000000000, 750000000 },
+      { -10,5, 2000000000, 1900000000 },
+      { -2000000000,-1, 2000000000,40 },
+      { INT_MIN,10, INT_MAX,30 },
+      { 10,INT_MIN, 30,INT_MAX },
+      { INT_MIN,INT_MIN, INT_MAX,INT_MAX }
+    };
+    for(int n=0; n < 6; n++)
+    {
+        for(int flip=0; flip < 2; flip++)
+        {
+            const int64_t* p = far[n] + (flip * 2);
+            const int64_t* q = far[n] + (2 - (flip * 2));
+
+            mono_gfx_fill(&canvas, 0);
+            mono_gfx_fill(&expected, 0);
+            mono_gfx_draw_line(&canvas, (int)p[0], (int)p[1], (int)q[0], (int)q[1], 1);
+            referenceFarLine(&expected, far[n][0], far[n][1], far[n][2], far[n][3], 0xFFFFFFFF, 32);
+            ASSERT_EQ(0, memcmp(canvas.mBuffer, expected.mBuffer, canvas.mBufferSize)) << "far line " << n << " " << flip;
+
+            mono_gfx_fill(&canvas, 0);
+            mono_gfx_fill(&expected, 0);
+            mono_gfx_draw_line_dashed(&canvas, (int)p[0], (int)p[1], (int)q[0], (int)q[1], 0xE4000000, 7, 1);
+            referenceFarLine(&expected, p[0], p[1], q[0], q[1], 0xE4000000, 7);
+            ASSERT_EQ(0, memcmp(canvas.mBuffer, expected.mBuffer, canvas.mBufferSize)) << "far dashed " << n << " " << flip;
+        }
+    }
+
+    //only the visible pixels are written
+    mono_gfx_init_unbuffered(&unbuffered, 45, 30, &countPixel, NULL);
+    mono_gfx_draw_line(&unbuffered, -1000000, 3, 1000000, 20, 1);
+    ASSERT_EQ(45, pixelCalls);
+    pixelCalls = 0;
+    mono_gfx_draw_line(&unbuffered, INT_MIN, 10, INT_MAX, 20, 1);
+    ASSERT_EQ(45, pixelCalls);
+
+    mono_gfx_deinit(&canvas);
+    mono_gfx_deinit(&expected);
+}
+
+//Test the buffered line kernels on canvases whose rows do and do not line up with bytes
+TEST(MonoGfxTest, lineKernelTest)
+{
+    const int widths[5] = {3, 8, 13, 64, 71};
+    uint32_t seed = 7;
+
+    for(int w=0; w < 5; w++)
+    {
+        mono_gfx_t expected;
+        mono_gfx_t inverted;
+        int width = widths[w];
+
+        mono_gfx_init_buffered(&canvas, width, 37);
+        mono_gfx_init_buffered(&expected, width, 37);
+        mono_gfx_init_buffered(&inverted, width, 37);
+
+        for(int n=0; n < 300; n++)
+        {
+            int c[4];
+            for(int i=0; i < 4; i++)
+            {
+                seed = seed * 1103515245 + 12345;
+                c[i] = (int)((seed >> 4) % 100) - 20;
+            }
+            //every slope from flat to steep
+            if(n % 3 == 0)
+                c[3] = c[1] + (n % 7) - 3;
+
+            bool steep = abs(c[3] - c[1]) > abs(c[2] - c[0]);
+            bool flip = steep ? (c[1] > c[3]) : (c[0] > c[2]);
+
+            mono_gfx_fill(&canvas, 0);
+            mono_gfx_fill(&expected, 0);
+            mono_gfx_fill(&inverted, 0);
+            mono_gfx_draw_line(&canvas, c[0], c[1], c[2], c[3], 1);
+            mono_gfx_draw_line(&inverted, c[0], c[1], c[2], c[3], 2);
+            if(flip)
+                referenceLine(&expected, c[2], c[3], c[0], c[1], 0xFFFFFFFF, 32);
+            else
+                referenceLine(&expected, c[0], c[1], c[2], c[3], 0xFFFFFFFF, 32);
+            ASSERT_EQ(0, memcmp(canvas.mBuffer, expected.mBuffer, canvas.mBufferSize)) << "width " << width << " line " << c[0] << "," << c[1] << " " << c[2] << "," << c[3];
+            ASSERT_EQ(0, memcmp(canvas.mBuffer, inverted.mBuffer, canvas.mBufferSize)) << "width " << width << " line " << c[0] << "," << c[1] << " " << c[2] << "," << c[3];
+
+            //pixels around the line are left alone when it is cleared
+            mono_gfx_fill(&canvas, 1);
+            mono_gfx_fill(&inverted, 0);
+            mono_gfx_draw_line_dashed(&canvas, c[0], c[1], c[2], c[3], 0xD8000000, 6, 0);
+            referenceLine(&inverted, c[0], c[1], c[2], c[3], 0xD8000000, 6);
+            for(int py=0; py < 37; py++)
+                for(int px=0; px < width; px++)
+                    ASSERT_EQ(!getPixel(&inverted, px, py), getPixel(&canvas, px, py)) << "width " << width << " dashed at " << px << "," << py;
+        }
+
+        mono_gfx_deinit(&canvas);
+        mono_gfx_deinit(&expected);
+        mono_gfx_deinit(&inverted);
+    }
+}
+
+//Test filled and outlined rects against testing every pixel
+TEST(MonoGfxTest, rectOutlineTest)
+{
+    const int widths[2] = {64, 61};
+    uint32_t seed = 5;
+
+    for(int c=0; c < 2; c++)
+    {
+        mono_gfx_t inverted;
+        int width = widths[c];
+
+        mono_gfx_init_buffered(&canvas, width, 40);
+        mono_gfx_init_buffered(&inverted, width, 40);
+
+        for(int n=0; n < 400; n++)
+        {
+            int r[4];
+            for(int i=0; i < 4; i++)
+            {
+                seed = seed * 1103515245 + 12345;
+                r[i] = (int)((seed >> 4) % 70);
+            }
+            int x = r[0] - 10, y = r[1] - 15, w = r[2] - 3, h = r[3] / 2 - 3;
+            int stroke = (n % 6);
+
+            mono_gfx_fill(&canvas, 0);
+            mono_gfx_fill(&inverted, 0);
+            if(stroke == 0)
+            {
+                mono_gfx_draw_rect(&canvas, x, y, w, h, 1);
+                mono_gfx_draw_rect(&inverted, x, y, w, h, 2);
+            }
+            else
+            {
+                mono_gfx_draw_rect_outline(&canvas, x, y, w, h, stroke, 1);
+                mono_gfx_draw_rect_outline(&inverted, x, y, w, h, stroke, 2);
+            }
+
+            for(int py=0; py < 40; py++)
+            {
+                for(int px=0; px < width; px++)
+                {
+                    bool inside = (px >= x) && (px < x + w) && (py >= y) && (py < y + h);
+                    bool edge = (stroke == 0) || (px < x + stroke) || (px >= x + w - stroke) || (py < y + stroke) || (py >= y + h - stroke);
+                    ASSERT_EQ(inside && edge, getPixel(&canvas, px, py)) << "width " << width << " rect " << x << "," << y << " " << w << "x" << h << " stroke " << stroke << " at " << px << "," << py;
+                }
+            }
+            ASSERT_EQ(0, memcmp(canvas.mBuffer, inverted.mBuffer, canvas.mBufferSize));
+        }
+
+        mono_gfx_deinit(&canvas);
+        mono_gfx_deinit(&inverted);
+    }
+}
+
+//reference 4-way flood fill, one pixel at a time. Marks the area in 'area' and returns its size
+static int referenceFill(mono_gfx_t* gfx, int x, int y, bool* area)
+{
+    static int queue[64 * 64];
+    int head = 0, tail = 0, count = 0;
+    bool old = getPixel(gfx, x, y);
+
+    memset(area, 0, gfx->mWidth * gfx->mHeight);
+    queue[tail++] = (y * gfx->mWidth) + x;
+    area[(y * gfx->mWidth) + x] = true;
+
+    while(head < tail)
+    {
+        int p = queue[head++];
+        int px = p % gfx->mWidth, py = p / gfx->mWidth;
+        const int dx[4] = {1, -1, 0, 0}, dy[4] = {0, 0, 1, -1};
+        count++;
+
+        for(int d=0; d < 4; d++)
+        {
+            int nx = px + dx[d], ny = py + dy[d];
+            if((nx < 0) || (nx >= gfx->mWidth) || (ny < 0) || (ny >= gfx->mHeight))
+                continue;
+            int n = (ny * gfx->mWidth) + nx;
+            if(!area[n] && (getPixel(gfx, nx, ny) == old))
+            {
+                area[n] = true;
+                queue[tail++] = n;
+            }
+        }
+    }
+    return count;
+}
+
+//Test flood fill against filling one pixel at a time
+TEST(MonoGfxTest, floodFillTest)
+{
+    const int widths[2] = {64, 53};
+    GFXfillSpan stack[256];
+    static bool area[64 * 64];
+    uint32_t seed = 77;
+    mono_gfx_t before;
+    mono_gfx_t unbuffered;
+
+    for(int c=0; c < 2; c++)
+    {
+        int width = widths[c];
+        mono_gfx_init_buffered(&canvas, width, 64);
+        mono_gfx_init_buffered(&before, width, 64);
+
+        for(int n=0; n < 100; n++)
+        {
+            //random walls, sparse enough to leave big winding areas
+            mono_gfx_fill(&canvas, (n % 2) ? MONO_GFX_PIXEL_ON : MONO_GFX_PIXEL_OFF);
+            for(int k=0; k < 40; k++)
+            {
+                seed = seed * 1103515245 + 12345;
+                int x0 = (seed >> 8) % width, y0 = (seed >> 16) % 64;
+                seed = seed * 1103515245 + 12345;
+                int x1 = (seed >> 8) % width, y1 = (seed >> 16) % 64;
+                mono_gfx_draw_line(&canvas, x0, y0, x1, y1, MONO_GFX_PIXEL_INVERT);
+            }
+            seed = seed * 1103515245 + 12345;
+            int sx = (seed >> 8) % width, sy = (seed >> 16) % 64;
+
+            memcpy(before.mBuffer, canvas.mBuffer, canvas.mBufferSize);
+            referenceFill(&before, sx, sy, area);
+            ASSERT_EQ(MRT_STATUS_OK, mono_gfx_flood_fill(&canvas, sx, sy, MONO_GFX_PIXEL_INVERT, stack, 256));
+
+            for(int py=0; py < 64; py++)
+                for(int px=0; px < width; px++)
+                    ASSERT_EQ(getPixel(&before, px, py) != area[(py * width) + px], getPixel(&canvas, px, py)) << "width " << width << " fill " << n << " at " << px << "," << py;
+        }
+
+        mono_gfx_deinit(&canvas);
+        mono_gfx_deinit(&before);
+    }
+
+    //a comb needs more stack than it is given. What was reached is filled, and filling again from a missed point carries on
+    mono_gfx_init_buffered(&canvas, 64, 64);
+    mono_gfx_init_buffered(&before, 64, 64);
+    mono_gfx_fill(&canvas, 0);
+    for(int x=2; x < 64; x += 4)
+        mono_gfx_draw_line(&canvas, x, 0, x, 60, 1);
+    memcpy(before.mBuffer, canvas.mBuffer, canvas.mBufferSize);
+    int size = referenceFill(&before, 0, 63, area);
+
+    ASSERT_EQ(MRT_STATUS_ERROR, mono_gfx_flood_fill(&canvas, 0, 63, 1, stack, 3));
+    int tries = 0;
+    for(int p=0; p < 64 * 64; p++)
+    {
+        if(area[p] && !getPixel(&canvas, p % 64, p / 64))
+        {
+            mono_gfx_flood_fill(&canvas, p % 64, p / 64, 1, stack, 3);
+            tries++;
+        }
+    }
+    ASSERT_GT(tries, 0);
+    int filled = 0;
+    for(int p=0; p < 64 * 64; p++)
+    {
+        ASSERT_EQ(getPixel(&before, p % 64, p / 64) || area[p], getPixel(&canvas, p % 64, p / 64));
+        filled += area[p];
+    }
+    ASSERT_EQ(size, filled);
+
+    //filling with the value that is already there does nothing
+    ASSERT_EQ(MRT_STATUS_OK, mono_gfx_flood_fill(&canvas, 0, 63, 1, stack, 3));
+
+    mono_gfx_init_unbuffered(&unbuffered, 64, 64, &countPixel, NULL);
+    ASSERT_EQ(MRT_STATUS_ERROR, mono_gfx_flood_fill(&unbuffered, 0, 0, 1, stack, 256));
+
+    mono_gfx_deinit(&canvas);
+    mono_gfx_deinit(&before);
+
+    //runs past x 32767 on a wide canvas, split by a wall at 33000
+    mono_gfx_init_buffered(&canvas, 40000, 3);
+    mono_gfx_draw_line(&canvas, 33000, 0, 33000, 1, 1);
+    ASSERT_EQ(MRT_STATUS_OK, mono_gfx_flood_fill(&canvas, 39000, 0, 1, stack, 256));
+    for(int x=0; x < 40000; x += 7)
+    {
+        ASSERT_TRUE(getPixel(&canvas, x, 0) && getPixel(&canvas, x, 1) && getPixel(&canvas, x, 2)) << "at " << x;
+    }
+    mono_gfx_deinit(&canvas);
+}
+
+//unbuffered canvas callbacks that draw into the buffered canvas in mDevice
+static mrt_status_t mirrorPixel(mono_gfx_t* gfx, int x, int y, uint8_t val)
+{
+    return mono_gfx_write_pixel((mono_gfx_t*)gfx->mDevice, x, y, val);
+}
+
+static mrt_status_t mirrorSpan(mono_gfx_t* gfx, int x0, int x1, int y, uint8_t val)
+{
+    spanCalls++;
+    for(int x = x0; x <= x1; x++)
+        mono_gfx_write_pixel((mono_gfx_t*)gfx->mDevice, x, y, val);
+    return MRT_STATUS_OK;
+}
+
+//draws one of the filled shapes used by patternTest
+static void patternShape(mono_gfx_t* gfx, int shape, uint8_t val)
+{
+    GFXpoint star[5] = {{30, 2}, {40, 38}, {8, 14}, {52, 14}, {20, 38}};
+
+    switch(shape)
+    {
+        case 0: mono_gfx_draw_rect(gfx, 3, 5, gfx->mWidth - 9, 30, val); break;
+        case 1: mono_gfx_draw_rect(gfx, 9, 1, 5, 37, val); break;
+        case 2: mono_gfx_fill_circle(gfx, 30, 20, 17, val); break;
+        case 3: mono_gfx_fill_round_rect(gfx, 2, 3, 50, 30, 9, val); break;
+        case 4: mono_gfx_fill_polygon(gfx, star, 5, MONO_GFX_FILL_NON_ZERO, val); break;
+        case 5: mono_gfx_fill_triangle(gfx, 1, 39, 33, 0, 58, 30, val); break;
+    }
+}
+
+//Test that filled shapes drawn with a brush only touch the pixels the brush covers
+TEST(MonoGfxTest, patternTest)
+{
+    const int widths[2] = {64, 61};
+    const uint8_t stripes[8] = {0xF0, 0x0F, 0xC3, 0x3C, 0x81, 0x7E, 0x01, 0x80};
+    mono_gfx_t solid;
+    mono_gfx_t mirror;
+    mono_gfx_t unbuffered;
+
+    //gray level n sets 4n pixels of each 8x8 block, and every level covers the one below it
+    for(int n=0; n < MONO_GFX_GRAY_LEVELS; n++)
+    {
+        int bits = 0;
+        for(int r=0; r < 8; r++)
+        {
+            bits += __builtin_popcount(mono_gfx_gray[n][r]);
+            if(n > 0)
+            {
+                ASSERT_EQ(mono_gfx_gray[n - 1][r], mono_gfx_gray[n - 1][r] & mono_gfx_gray[n][r]);
+            }
+        }
+        ASSERT_EQ(n * 4, bits);
+    }
+
+    for(int c=0; c < 2; c++)
+    {
+        int width = widths[c];
+        mono_gfx_init_buffered(&canvas, width, 40);
+        mono_gfx_init_buffered(&solid, width, 40);
+        mono_gfx_init_buffered(&mirror, width, 40);
+        mono_gfx_init_unbuffered(&unbuffered, width, 40, &mirrorPixel, &mirror);
+
+        for(int shape=0; shape < 6; shape++)
+        {
+            for(uint8_t val=0; val < 3; val++)
+            {
+                const uint8_t* pattern = (shape % 2) ? stripes : mono_gfx_gray[5 + shape];
+
+                mono_gfx_fill(&solid, 0);
+                patternShape(&solid, shape, 1);
+
+                //start from a half set background so every pixel value shows up
+                mono_gfx_fill(&canvas, 0);
+                mono_gfx_fill(&mirror, 0);
+                mono_gfx_draw_rect(&canvas, 0, 0, width / 2, 40, 1);
+                mono_gfx_draw_rect(&mirror, 0, 0, width / 2, 40, 1);
+
+                canvas.mPattern = pattern;
+                unbuffered.mPattern = pattern;
+                unbuffered.fWriteSpan = (val == 1) ? &mirrorSpan : NULL;
+                patternShape(&canvas, shape, val);
+                patternShape(&unbuffered, shape, val);
+                canvas.mPattern = NULL;
+
+                for(int y=0; y < 40; y++)
+                {
+                    for(int x=0; x < width; x++)
+                    {
+                        bool background = (x < width / 2);
+                        bool brush = (pattern[y % 8] >> (7 - (x % 8))) & 1;
+                        bool expect = background;
+
+                        if(getPixel(&solid, x, y) && brush)
+                            expect = (val == MONO_GFX_PIXEL_INVERT) ? !background : (val == MONO_GFX_PIXEL_ON);
+
+                        ASSERT_EQ(expect, getPixel(&canvas, x, y)) << "width " << width << " shape " << shape << " val " << (int)val << " at " << x << "," << y;
+                        ASSERT_EQ(expect, getPixel(&mirror, x, y)) << "unbuffered, width " << width << " shape " << shape << " val " << (int)val << " at " << x << "," << y;
+                    }
+                }
+            }
+        }
+
+        //outlines, thick lines and scrolled in rows stay solid
+        mono_gfx_fill(&canvas, 0);
+        mono_gfx_fill(&solid, 0);
+        canvas.mPattern = mono_gfx_gray[8];
+        mono_gfx_draw_rect_outline(&canvas, 2, 2, 40, 30, 3, 1);
+        mono_gfx_draw_round_rect(&canvas, 5, 5, 30, 20, 6, 1);
+        mono_gfx_draw_line_thick(&canvas, 0, 39, 50, 10, 6, MONO_GFX_CAP_ROUND, 1);
+        mono_gfx_scroll(&canvas, 0, 0, width, 40, 5, 1);
+        canvas.mPattern = NULL;
+        mono_gfx_draw_rect_outline(&solid, 2, 2, 40, 30, 3, 1);
+        mono_gfx_draw_round_rect(&solid, 5, 5, 30, 20, 6, 1);
+        mono_gfx_draw_line_thick(&solid, 0, 39, 50, 10, 6, MONO_GFX_CAP_ROUND, 1);
+        mono_gfx_scroll(&solid, 0, 0, width, 40, 5, 1);
+        ASSERT_EQ(0, memcmp(canvas.mBuffer, solid.mBuffer, canvas.mBufferSize));
+
+        mono_gfx_deinit(&canvas);
+        mono_gfx_deinit(&solid);
+        mono_gfx_deinit(&mirror);
+    }
+}
+
+//reads one pixel of a packed bitmap
+static bool bmpPixel(const uint8_t* data, int width, int x, int y)
+{
+    uint32_t bit = (uint32_t)y * width + x;
+    return (data[bit / 8] >> (7 - (bit % 8))) & 1;
+}
+
+//Test converting gray images to packed bitmaps
+TEST(MonoGfxTest, ditherTest)
+{
+    const int widths[4] = {5, 61, 64, 100};
+    static uint8_t gray[100 * 64];
+    static uint8_t out[(100 * 64 + 7) / 8 + 1];
+    static uint8_t streamed[(100 * 64 + 7) / 8];
+    static int16_t err[MONO_GFX_DITHER_ERR_LEN(100)];
+    mono_gfx_dither_t dither;
+    uint32_t seed = 3;
+
+    for(int i=0; i < 100 * 64; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        gray[i] = (uint8_t)(seed >> 16);
+    }
+
+    //threshold and ordered dithering set exactly the pixels at or above their level, with rows packed back to back like GFXBmp
+    for(int c=0; c < 4; c++)
+    {
+        int width = widths[c];
+        int size = (width * 9 + 7) / 8;
+
+        for(uint8_t method = MONO_GFX_DITHER_THRESHOLD; method <= MONO_GFX_DITHER_BAYER; method++)
+        {
+            memset(out, 0xA5, sizeof(out));
+            ASSERT_EQ(MRT_STATUS_OK, mono_gfx_dither_init(&dither, out, width, 9, method, NULL));
+            dither.mLevel = 100;
+            mono_gfx_dither_image(&dither, gray, 100);
+            ASSERT_EQ(MRT_STATUS_ERROR, mono_gfx_dither_row(&dither, gray));
+            ASSERT_EQ(0xA5, out[size]);
+
+            GFXBmp bmp = {out, width, 9};
+            mono_gfx_init_buffered(&canvas, 100, 9);
+            mono_gfx_draw_bmp(&canvas, 0, 0, &bmp, MONO_GFX_PIXEL_ON);
+
+            for(int y=0; y < 9; y++)
+            {
+                for(int x=0; x < width; x++)
+                {
+                    int level = (method == MONO_GFX_DITHER_THRESHOLD) ? 100 : _bayer[y % 8][x % 8];
+                    ASSERT_EQ(gray[y * 100 + x] >= level, bmpPixel(out, width, x, y)) << "width " << width << " method " << (int)method << " at " << x << "," << y;
+                    ASSERT_EQ(gray[y * 100 + x] >= level, getPixel(&canvas, x, y));
+                }
+            }
+            mono_gfx_deinit(&canvas);
+        }
+    }
+
+    //error diffusion needs its row buffer
+    ASSERT_EQ(MRT_STATUS_ERROR, mono_gfx_dither_init(&dither, out, 64, 64, MONO_GFX_DITHER_FLOYD_STEINBERG, NULL));
+    ASSERT_EQ(MRT_STATUS_ERROR, mono_gfx_dither_init(&dither, out, 64, 64, 4, err));
+
+    //flat fields come out with the right share of pixels set. Atkinson drops some error, so its grays get darker or lighter
+    //towards the ends (and go solid near them), but still keep their order
+    const uint8_t levels[6] = {0, 32, 64, 128, 192, 255};
+    for(uint8_t method = MONO_GFX_DITHER_BAYER; method <= MONO_GFX_DITHER_ATKINSON; method++)
+    {
+        double last = -1;
+
+        for(int l=0; l < 6; l++)
+        {
+            static uint8_t flat[100 * 64];
+            memset(flat, levels[l], sizeof(flat));
+            ASSERT_EQ(MRT_STATUS_OK, mono_gfx_dither_init(&dither, out, 100, 64, method, err));
+            mono_gfx_dither_image(&dither, flat, 100);
+
+            int set = 0;
+            for(int p=0; p < 100 * 64; p++)
+                set += bmpPixel(out, 100, p % 100, p / 100);
+
+            double share = (double)set / (100 * 64);
+            if((method != MONO_GFX_DITHER_ATKINSON) || (levels[l] == 128))
+            {
+                ASSERT_NEAR(levels[l] / 255.0, share, 0.01) << "method " << (int)method << " level " << (int)levels[l];
+            }
+            if((levels[l] == 0) || (levels[l] == 255))
+            {
+                ASSERT_EQ((levels[l] == 255) ? 100 * 64 : 0, set);
+            }
+            ASSERT_GE(share, last);
+            last = share;
+        }
+    }
+
+    //feeding rows one at a time gives the same image as converting it all at once
+    for(int c=0; c < 4; c++)
+    {
+        int width = widths[c];
+        int size = (width * 64 + 7) / 8;
+
+        for(uint8_t method = MONO_GFX_DITHER_FLOYD_STEINBERG; method <= MONO_GFX_DITHER_ATKINSON; method++)
+        {
+            mono_gfx_dither_init(&dither, out, width, 64, method, err);
+            mono_gfx_dither_image(&dither, gray, 100);
+
+            mono_gfx_dither_init(&dither, streamed, width, 64, method, err);
+            for(int y=0; y < 64; y++)
+            {
+                uint8_t row[100];
+                memcpy(row, &gray[y * 100], width);
+                ASSERT_EQ(MRT_STATUS_OK, mono_gfx_dither_row(&dither, row));
+            }
+            ASSERT_EQ(0, memcmp(out, streamed, size));
+        }
+    }
+}
+
+//point at t on a quadratic or cubic Bezier curve
+static void bezierPoint(const GFXpoint* p, int order, double t, double* x, double* y)
+{
+    double u = 1 - t;
+
+    if(order == 2)
+    {
+        *x = u * u * p[0].x + 2 * u * t * p[1].x + t * t * p[2].x;
+        *y = u * u * p[0].y + 2 * u * t * p[1].y + t * t * p[2].y;
+    }
+    else
+    {
+        *x = u * u * u * p[0].x + 3 * u * u * t * p[1].x + 3 * u * t * t * p[2].x + t * t * t * p[3].x;
+        *y = u * u * u * p[0].y + 3 * u * u * t * p[1].y + 3 * u * t * t * p[2].y + t * t * t * p[3].y;
+    }
+}
+
+//Test drawing and filling Bezier curves
+TEST(MonoGfxTest, bezierTest)
+{
+    mono_gfx_t inverted;
+    mono_gfx_t mirror;
+    mono_gfx_t unbuffered;
+    const GFXpoint curves[6][7] = {
+        {{2, 60}, {40, -30}, {90, 60}},                                 //quadratic arch
+        {{5, 5}, {120, 10}, {10, 55}, {118, 60}},                       //cubic S
+        {{10, 50}, {110, 0}, {10, 0}, {110, 50}},                       //cubic with a loop
+        {{60, 5}, {60, 5}, {60, 5}, {60, 5}},                           //a single point
+        {{-40, 70}, {64, -60}, {180, 70}},                              //mostly off the canvas
+        {{10, 32}, {30, 2}, {50, 32}, {70, 62}, {90, 32}, {110, 2}, {120, 32}}   //chain of 3 quadratic curves
+    };
+    const int orders[6] = {2, 3, 3, 3, 2, 2};
+    const int counts[6] = {3, 4, 4, 4, 3, 7};
+
+    mono_gfx_init_buffered(&canvas, 128, 64);
+    mono_gfx_init_buffered(&inverted, 128, 64);
+    mono_gfx_init_buffered(&mirror, 128, 64);
+    mono_gfx_init_unbuffered(&unbuffered, 128, 64, &mirrorPixel, &mirror);
+
+    for(int c=0; c < 6; c++)
+    {
+        const GFXpoint* p = curves[c];
+        int order = orders[c];
+
+        mono_gfx_fill(&canvas, 0);
+        mono_gfx_fill(&inverted, 0);
+        mono_gfx_fill(&mirror, 0);
+        ASSERT_EQ(MRT_STATUS_OK, mono_gfx_draw_bezier(&canvas, p, counts[c], order, MONO_GFX_PIXEL_ON));
+        mono_gfx_draw_bezier(&inverted, p, counts[c], order, MONO_GFX_PIXEL_INVERT);
+        mono_gfx_draw_bezier(&unbuffered, p, counts[c], order, MONO_GFX_PIXEL_ON);
+
+        //the loop crosses itself, everything else draws each pixel once
+        if(c != 2)
+        {
+            ASSERT_EQ(0, memcmp(canvas.mBuffer, inverted.mBuffer, canvas.mBufferSize)) << "curve " << c;
+        }
+        ASSERT_EQ(0, memcmp(canvas.mBuffer, mirror.mBuffer, canvas.mBufferSize)) << "curve " << c;
+
+        //every drawn pixel is near the curve, and the curve never passes more than a pixel from a drawn one
+        std::vector<double> xs, ys;
+        for(int i=0; i + order < counts[c]; i += order)
+        {
+            for(int s=0; s <= 2000; s++)
+            {
+                double x, y;
+                bezierPoint(&p[i], order, s / 2000.0, &x, &y);
+                xs.push_back(x);
+                ys.push_back(y);
+            }
+        }
+
+        for(int y=0; y < 64; y++)
+        {
+            for(int x=0; x < 128; x++)
+            {
+                if(!getPixel(&canvas, x, y))
+                    continue;
+
+                double best = 1e9;
+                for(size_t i=0; i < xs.size(); i++)
+                    best = fmin(best, fmax(fabs(xs[i] - x), fabs(ys[i] - y)));
+                ASSERT_LE(best, 1.0) << "curve " << c << " stray pixel at " << x << "," << y;
+            }
+        }
+
+        for(size_t i=0; i < xs.size(); i++)
+        {
+            int px = (int)floor(xs[i] + 0.5), py = (int)floor(ys[i] + 0.5);
+            if((px < 1) || (px > 126) || (py < 1) || (py > 62))
+                continue;
+
+            bool near = false;
+            for(int dy=-1; dy <= 1; dy++)
+                for(int dx=-1; dx <= 1; dx++)
+                    near = near || getPixel(&canvas, px + dx, py + dy);
+            ASSERT_TRUE(near) << "curve " << c << " gap near " << px << "," << py;
+        }
+    }
+
+    //straight curves are one segment, and bigger or tighter curves get more
+    const GFXpoint straight[4] = {{0, 0}, {10, 10}, {20, 20}, {30, 30}};
+    const GFXpoint small[3] = {{0, 0}, {10, 20}, {20, 0}};
+    const GFXpoint big[3] = {{0, 0}, {40, 80}, {80, 0}};
+    ASSERT_EQ(1, _bezier_steps(straight, 3));
+    ASSERT_EQ(1, _bezier_steps(straight, 2));
+    ASSERT_GT(_bezier_steps(big, 2), _bezier_steps(small, 2));
+    ASSERT_LE(_bezier_steps(big, 2), 2 * _bezier_steps(small, 2) + 1);
+
+    //a circle made of 4 cubic curves fills about the same pixels as a circle
+    mono_gfx_t circle;
+    mono_gfx_init_buffered(&circle, 128, 64);
+    const int k = 11;   //0.5523 * r, for r = 20
+    const GFXpoint round[13] = {{64, 12}, {64 + k, 12}, {84, 32 - k}, {84, 32}, {84, 32 + k}, {64 + k, 52}, {64, 52},
+                                {64 - k, 52}, {44, 32 + k}, {44, 32}, {44, 32 - k}, {64 - k, 12}, {64, 12}};
+    mono_gfx_fill(&canvas, 0);
+    mono_gfx_fill(&circle, 0);
+    ASSERT_EQ(MRT_STATUS_OK, mono_gfx_fill_bezier(&canvas, round, 13, 3, MONO_GFX_FILL_NON_ZERO, MONO_GFX_PIXEL_ON));
+    mono_gfx_fill_circle(&circle, 64, 32, 20, MONO_GFX_PIXEL_ON);
+    for(int y=0; y < 64; y++)
+    {
+        for(int x=0; x < 128; x++)
+        {
+            double d = sqrt((x - 64.0) * (x - 64.0) + (y - 32.0) * (y - 32.0));
+            if(d < 19)
+            {
+                ASSERT_TRUE(getPixel(&canvas, x, y)) << x << "," << y;
+            }
+            if(d > 20.5)
+            {
+                ASSERT_FALSE(getPixel(&canvas, x, y)) << x << "," << y;
+            }
+        }
+    }
+
+    //outlines that need more points than the polygon filler takes are flattened more coarsely
+    GFXpoint wave[1 + 3 * 30];
+    wave[0].x = 4;
+    wave[0].y = 60;
+    for(int i=0; i < 30; i++)
+    {
+        int x = 4 + (i * 4);
+        wave[1 + 3 * i].x = x + 1;
+        wave[1 + 3 * i].y = (i % 2) ? 60 : 0;
+        wave[2 + 3 * i].x = x + 3;
+        wave[2 + 3 * i].y = (i % 2) ? 60 : 0;
+        wave[3 + 3 * i].x = x + 4;
+        wave[3 + 3 * i].y = 30;
+    }
+    mono_gfx_fill(&canvas, 0);
+    ASSERT_EQ(MRT_STATUS_OK, mono_gfx_fill_bezier(&canvas, wave, 1 + 3 * 30, 3, MONO_GFX_FILL_EVEN_ODD, MONO_GFX_PIXEL_ON));
+    ASSERT_TRUE(getPixel(&canvas, 60, 40));
+
+    //control points far off the canvas: a parabola of height A with its vertex at 64,20, which is y - 20 = (x - 64)^2 / 8 near the vertex.
+    //The segments are chords of the curve, so every pixel is inside it, give or take the pixel a line can stray by
+    const int64_t heights[4] = {10000000, 100000000, 500000000, 2000000000};
+    for(int n=0; n < 4; n++)
+    {
+        int64_t A = heights[n];
+        int64_t w = (int64_t)sqrt(8.0 * (double)A);
+        const GFXpoint arch[3] = {{(int)(64 - w), (int)(20 + A)}, {64, (int)(20 - A)}, {(int)(64 + w), (int)(20 + A)}};
+        int set = 0;
+
+        mono_gfx_fill(&canvas, 0);
+        ASSERT_EQ(MRT_STATUS_OK, mono_gfx_draw_bezier(&canvas, arch, 3, 2, MONO_GFX_PIXEL_ON));
+        ASSERT_TRUE(getPixel(&canvas, 64, 20)) << "far arch " << n;
+        for(int y=0; y < 64; y++)
+        {
+            for(int x=0; x < 128; x++)
+            {
+                if(!getPixel(&canvas, x, y))
+                    continue;
+                int64_t off = (llabs(x - 64) > 0) ? llabs(x - 64) - 1 : 0;
+                ASSERT_GE((y + 1 - 20) * w * w, A * off * off) << "far arch " << n << " stray pixel at " << x << "," << y;
+                set++;
+            }
+        }
+        ASSERT_GT(set, 2) << "far arch " << n;
+
+        mono_gfx_fill(&canvas, 0);
+        if(20 + A > MONO_GFX_BEZIER_FILL_LIMIT)
+        {
+            ASSERT_EQ(MRT_STATUS_ERROR, mono_gfx_fill_bezier(&canvas, arch, 3, 2, MONO_GFX_FILL_EVEN_ODD, MONO_GFX_PIXEL_ON)) << "far arch " << n;
+            continue;
+        }
+        ASSERT_EQ(MRT_STATUS_OK, mono_gfx_fill_bezier(&canvas, arch, 3, 2, MONO_GFX_FILL_EVEN_ODD, MONO_GFX_PIXEL_ON));
+        for(int y=0; y < 64; y++)
+        {
+            for(int x=0; x < 128; x++)
+            {
+                if(getPixel(&canvas, x, y))
+                {
+                    ASSERT_GE((y - 20) * w * w, A * (x - 64) * (x - 64)) << "far arch " << n << " filled outside at " << x << "," << y;
+                }
+            }
+        }
+        for(int y=21; y < 64; y++)
+        {
+            ASSERT_TRUE(getPixel(&canvas, 64, y)) << "far arch " << n << " gap at 64," << y;
+        }
+    }
+
+    //a cubic curve with its control points at the corners of the int range
+    const GFXpoint wide[4] = {{INT_MIN, 10}, {INT_MAX, 10}, {INT_MIN, 40}, {INT_MAX, 40}};
+    mono_gfx_fill(&canvas, 0);
+    mono_gfx_fill(&inverted, 0);
+    ASSERT_EQ(MRT_STATUS_OK, mono_gfx_draw_bezier(&canvas, wide, 4, 3, MONO_GFX_PIXEL_ON));
+    ASSERT_NE(0, memcmp(canvas.mBuffer, inverted.mBuffer, canvas.mBufferSize));
+    ASSERT_EQ(MRT_STATUS_ERROR, mono_gfx_fill_bezier(&canvas, wide, 4, 3, MONO_GFX_FILL_EVEN_ODD, MONO_GFX_PIXEL_ON));
+
+    //bad chains
+    ASSERT_EQ(MRT_STATUS_ERROR, mono_gfx_draw_bezier(&canvas, round, 13, 4, MONO_GFX_PIXEL_ON));
+    ASSERT_EQ(MRT_STATUS_ERROR, mono_gfx_draw_bezier(&canvas, round, 12, 3, MONO_GFX_PIXEL_ON));
+    ASSERT_EQ(MRT_STATUS_ERROR, mono_gfx_fill_bezier(&canvas, round, 2, 2, MONO_GFX_FILL_EVEN_ODD, MONO_GFX_PIXEL_ON));
+
+    mono_gfx_deinit(&canvas);
+    mono_gfx_deinit(&inverted);
+    mono_gfx_deinit(&mirror);
+    mono_gfx_deinit(&circle);
+}
+
 #endif
@@ -0,0 +1,269 @@
+#!/usr/bin/env python3
+"""
+@file font_subset.py
+@brief generates a subset of a GFXfont header containing only the characters that are used
+@author Jason Berger
+
+Example:
+    python3 Tools/font_subset.py Fonts/FreeSans18pt7b.h --chars "0123456789.-" --text "°C" -o clock_font.h
+    python3 Tools/font_subset.py Fonts/TomThumb.h --define TOMTHUMB_USE_EXTENDED=0 --chars "0123456789" -o small_font.h
+
+The output font packs only the needed glyph bitmaps (identical bitmaps are shared), remaps the
+bitmap offsets, and puts the longest run of consecutive characters in the first..last block.
+Everything else goes into a sorted GFXrange table so sparse characters do not pad the glyph array.
+
+#if/#ifdef/#ifndef/#elif/#else/#endif blocks in the source header are evaluated the same way the compiler would,
+using the #defines in the header and any given with --define.
+"""
+
+import argparse
+import re
+import sys
+import warnings
+
+def strip_comments(text):
+    text = re.sub(r'/\*.*?\*/', '', text, flags=re.S)
+    return re.sub(r'//[^\n]*', '', text)
+
+def parse_array(text, name):
+    """returns the body of a C array named <name>[]"""
+    m = re.search(r'\b' + re.escape(name) + r'\s*\[\s*\]\s*[^=]*=\s*\{(.*?)\}\s*;', text, re.S)
+    if m is None:
+        return None
+    return m.group(1)
+
+def eval_condition(expr, defines, path, line_no):
+    """evaluates the expression of an #if or #elif line"""
+    source = expr
+    expr = re.sub(r'\bdefined\s*\(\s*(\w+)\s*\)|\bdefined\s+(\w+)',
+                  lambda m: '1' if (m.group(1) or m.group(2)) in defines else '0', expr)
+
+    # identifiers are replaced by their value, undefined ones are 0 like in C
+    def value(m):
+        v = defines.get(m.group(0), '0')
+        return '(' + (v if v != '' else '1') + ')'
+    for _ in range(8):
+        expanded = re.sub(r'\b[A-Za-z_]\w*\b', value, expr)
+        if expanded == expr:
+            break
+        expr = expanded
+
+    py = expr.replace('&&', ' and ').replace('||', ' or ')
+    py = re.sub(r'!(?!=)', ' not ', py)
+    py = re.sub(r'\b(0[xX][0-9a-fA-F]+|\d+)[uUlL]*\b', r'\1', py)
+    if not re.fullmatch(r'(?:\s+|0[xX][0-9a-fA-F]+|\d+|\bnot\b|\band\b|\bor\b|[()+\-*/%<>=!&|~^])*', py):
+        sys.exit("%s:%d: can not evaluate #if %s" % (path, line_no, source))
+    try:
+        with warnings.catch_warnings():
+            warnings.simplefilter('ignore')
+            return bool(eval(py.replace('/', '//'), {'__builtins__': {}}))
+    except Exception:
+        sys.exit("%s:%d: can not evaluate #if %s" % (path, line_no, source))
+
+def preprocess(text, defines, path):
+    """keeps only the lines of active #if blocks and collects #defines along the way"""
+    defines = dict(defines)
+    out = []
+    stack = [] # (this branch is active, a branch of this block was taken, enclosing block is active)
+    active = True
+    for line_no, line in enumerate(text.split('\n'), 1):
+        m = re.match(r'\s*#\s*(\w+)\s*(.*)', line)
+        if m is None:
+            out.append(line if active else '')
+            continue
+        directive, rest = m.group(1), m.group(2).strip()
+        if directive in ('if', 'ifdef', 'ifndef'):
+            if directive == 'ifdef':
+                taken = rest.split()[0] in defines
+            elif directive == 'ifndef':
+                taken = rest.split()[0] not in defines
+            else:
+                taken = active and eval_condition(rest, defines, path, line_no)
+            stack.append((active and taken, taken, active))
+        elif directive in ('elif', 'else'):
+            if not stack:
+                sys.exit("%s:%d: #%s without #if" % (path, line_no, directive))
+            _, done, outer = stack.pop()
+            taken = not done and (directive == 'else' or (outer and eval_condition(rest, defines, path, line_no)))
+            stack.append((outer and taken, done or taken, outer))
+        elif directive == 'endif':
+            if not stack:
+                sys.exit("%s:%d: #endif without #if" % (path, line_no))
+            stack.pop()
+        elif directive == 'define' and active:
+            d = re.match(r'(\w+)(\(?)\s*(.*)', rest)
+            if d and not d.group(2) and d.group(1) not in defines:
+                defines[d.group(1)] = d.group(3).strip()
+        elif directive == 'undef' and active:
+            defines.pop(rest.split()[0], None)
+        active = stack[-1][0] if stack else True
+        out.append('')
+    if stack:
+        sys.exit("%s: unterminated #if" % path)
+    return '\n'.join(out)
+
+def parse_font(path, defines={}):
+    raw = open(path).read()
+    text = preprocess(strip_comments(raw), defines, path)
+
+    m = re.search(r'const\s+GFXfont\s+(\w+)\s*=\s*\{(.*?)\}\s*;', text, re.S)
+    if m is None:
+        sys.exit("no GFXfont found in " + path)
+    font_name = m.group(1)
+    fields = [f.strip() for f in m.group(2).split(',')]
+
+    bitmap_name = re.search(r'\)\s*(\w+)', fields[0]).group(1)
+    glyph_name = re.search(r'\)\s*(\w+)', fields[1]).group(1)
+    first = int(fields[2], 0)
+    last = int(fields[3], 0)
+    y_advance = int(fields[4], 0)
+
+    bitmaps = [int(v, 0) for v in parse_array(text, bitmap_name).replace('\n', ' ').split(',') if v.strip()]
+    glyphs = [tuple(int(v, 0) for v in g.split(',')) for g in re.findall(r'\{([^{}]*)\}', parse_array(text, glyph_name) + '}')]
+
+    # map codepoints to glyph indices
+    cmap = {}
+    for cp in range(first, last + 1):
+        cmap[cp] = cp - first
+
+    # fonts generated by this tool may already carry extra ranges
+    if len(fields) > 5 and fields[5] not in ('NULL', '0'):
+        for r in re.findall(r'\{([^{}]*)\}', parse_array(text, fields[5]) + '}'):
+            r_first, r_last, r_index = (int(v, 0) for v in r.split(','))
+            for cp in range(r_first, r_last + 1):
+                cmap[cp] = r_index + (cp - r_first)
+
+    if len(fields) > 7 and fields[7] not in ('NULL', '0'):
+        print("warning: kerning table is not carried over to the subset", file=sys.stderr)
+
+    return font_name, bitmaps, glyphs, cmap, y_advance
+
+def glyph_bitmap(bitmaps, glyph):
+    size = (glyph[1] * glyph[2] + 7) // 8
+    return bytes(bitmaps[glyph[0]:glyph[0] + size])
+
+def longest_run(cps):
+    """finds the longest run of consecutive codepoints that fit in the uint8_t first..last block"""
+    best = (1, 0) # empty block
+    start = None
+    for i, cp in enumerate(cps):
+        if cp > 0xFF:
+            break
+        if start is None or cp != cps[i - 1] + 1:
+            start = cp
+        if (cp - start) > (best[1] - best[0]):
+            best = (start, cp)
+    return best
+
+def char_comment(cp):
+    if 0x20 <= cp <= 0x7E:
+        return "0x%02X '%s'" % (cp, chr(cp))
+    return "U+%04X" % cp
+
+def main():
+    parser = argparse.ArgumentParser(description="Generate a subset of a GFXfont header")
+    parser.add_argument('font', help="source font header (e.g. Fonts/FreeSans12pt7b.h)")
+    parser.add_argument('--chars', default='', help="characters to keep")
+    parser.add_argument('--text', action='append', default=[], help="sample string, all of its characters are kept")
+    parser.add_argument('--text-file', action='append', default=[], help="UTF-8 file of sample strings")
+    parser.add_argument('--name', help="name of the generated font (default <font>Subset)")
+    parser.add_argument('-D', '--define', action='append', default=[], metavar='NAME[=VALUE]',
+                        help="macro used by #if blocks in the source header, overrides a #define in the header")
+    parser.add_argument('-o', '--output', help="output header (default stdout)")
+    args = parser.parse_args()
+
+    defines = {}
+    for d in args.define:
+        name, _, value = d.partition('=')
+        defines[name.strip()] = value.strip() if value else '1'
+
+    font_name, bitmaps, glyphs, cmap, y_advance = parse_font(args.font, defines)
+    name = args.name or (font_name + "Subset")
+
+    wanted = set(args.chars)
+    for t in args.text:
+        wanted |= set(t)
+    for f in args.text_file:
+        wanted |= set(open(f, encoding='utf-8').read())
+    wanted.discard('\n')
+    wanted.discard('\r')
+
+    cps = sorted(ord(c) for c in wanted)
+    missing = [cp for cp in cps if cp not in cmap]
+    for cp in missing:
+        print("warning: %s is not in %s" % (char_comment(cp), font_name), file=sys.stderr)
+    cps = [cp for cp in cps if cp in cmap]
+    if not cps:
+        sys.exit("no characters to keep")
+
+    # primary block first, then everything else in codepoint order
+    first, last = longest_run(cps)
+    order = [cp for cp in cps if first <= cp <= last] + [cp for cp in cps if not (first <= cp <= last)]
+
+    out_bitmaps = bytearray()
+    shared = {}
+    out_glyphs = []
+    for cp in order:
+        g = glyphs[cmap[cp]]
+        data = glyph_bitmap(bitmaps, g)
+        if data not in shared:
+            shared[data] = len(out_bitmaps)
+            out_bitmaps += data
+        out_glyphs.append((shared[data],) + g[1:] + (cp,))
+
+    # merge the remaining codepoints into ranges
+    ranges = []
+    for i, cp in enumerate(order):
+        if first <= cp <= last:
+            continue
+        if ranges and ranges[-1][1] == cp - 1:
+            ranges[-1][1] = cp
+        else:
+            ranges.append([cp, cp, i])
+
+    lines = []
+    lines.append("// Subset of %s generated by Tools/font_subset.py" % font_name)
+    lines.append("")
+    lines.append("static const uint8_t %sBitmaps[]  = {" % name)
+    row = []
+    for i, b in enumerate(out_bitmaps):
+        row.append("0x%02X" % b)
+    for i in range(0, len(row), 12):
+        lines.append("  " + ", ".join(row[i:i + 12]) + ("," if i + 12 < len(row) else " };"))
+    if not row:
+        lines.append("  0x00 };")
+    lines.append("")
+    lines.append("static const GFXglyph %sGlyphs[]  = {" % name)
+    for i, g in enumerate(out_glyphs):
+        end = "," if i + 1 < len(out_glyphs) else " };"
+        lines.append("  { %5d, %3d, %3d, %3d, %4d, %4d }%s   // %s" % (g[0], g[1], g[2], g[3], g[4], g[5], end, char_comment(g[6])))
+    lines.append("")
+    if ranges:
+        lines.append("static const GFXrange %sRanges[]  = {" % name)
+        for i, r in enumerate(ranges):
+            end = "," if i + 1 < len(ranges) else " };"
+            lines.append("  { 0x%04X, 0x%04X, %3d }%s" % (r[0], r[1], r[2], end))
+        lines.append("")
+    lines.append("static GFXfontCache %sCache;" % name)
+    lines.append("")
+    lines.append("const GFXfont %s  = {" % name)
+    lines.append("  (uint8_t  *)%sBitmaps," % name)
+    lines.append("  (GFXglyph *)%sGlyphs," % name)
+    lines.append("  0x%02X, 0x%02X, %d," % (first, last, y_advance))
+    if ranges:
+        lines.append("  %sRanges, %d," % (name, len(ranges)))
+    else:
+        lines.append("  NULL, 0,")
+    lines.append("  NULL, NULL, &%sCache };" % name)
+    lines.append("")
+    lines.append("// Approx. %d bytes" % (len(out_bitmaps) + len(out_glyphs) * 7 + len(ranges) * 10 + 7))
+    lines.append("")
+
+    out = "\n".join(lines)
+    if args.output:
+        open(args.output, 'w').write(out)
+    else:
+        sys.stdout.write(out)
+
+if __name__ == '__main__':
+    main()
@@ -6,8 +6,11 @@
   */
 
 #include "mono_gfx.h"
+#include "mono_gfx_text_cache.h"
+#include "mono_gfx_font_pager.h"
 #include "string.h"
 #include <stdlib.h>
+#include <limits.h>
 
 #ifndef _swap_int
 #define _swap_int(a, b) { int t = a; a = b; b = t; }
@@ -22,15 +25,349 @@ extern "C"
 {
 #endif
 
+//bit spreading tables for scaled drawing, each maps a nibble to the nibble with every bit repeated 2,3, or 4 times
+static const uint8_t _spread2[16] = {
+  0x00, 0x03, 0x0C, 0x0F, 0x30, 0x33, 0x3C, 0x3F, 0xC0, 0xC3, 0xCC, 0xCF, 0xF0, 0xF3, 0xFC, 0xFF
+};
+static const uint16_t _spread3[16] = {
+  0x000, 0x007, 0x038, 0x03F, 0x1C0, 0x1C7, 0x1F8, 0x1FF, 0xE00, 0xE07, 0xE38, 0xE3F, 0xFC0, 0xFC7, 0xFF8, 0xFFF
+};
+static const uint16_t _spread4[16] = {
+  0x0000, 0x000F, 0x00F0, 0x00FF, 0x0F00, 0x0F0F, 0x0FF0, 0x0FFF, 0xF000, 0xF00F, 0xF0F0, 0xF0FF, 0xFF00, 0xFF0F, 0xFFF0, 0xFFFF
+};
+
+//applies a pixel value to the bits of a buffer byte selected by mask
+static inline void _apply(uint8_t* dst, uint8_t mask, uint8_t val)
+{
+  if(val == MONO_GFX_PIXEL_OFF)
+    *dst &= ~mask;
+  else if(val == MONO_GFX_PIXEL_INVERT)
+    *dst ^= mask;
+  else
+    *dst |= mask;
+}
+
+const uint8_t mono_gfx_gray[MONO_GFX_GRAY_LEVELS][8] = {
+  {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+  {0x88, 0x00, 0x00, 0x00, 0x88, 0x00, 0x00, 0x00},
+  {0x88, 0x00, 0x22, 0x00, 0x88, 0x00, 0x22, 0x00},
+  {0xAA, 0x00, 0x22, 0x00, 0xAA, 0x00, 0x22, 0x00},
+  {0xAA, 0x00, 0xAA, 0x00, 0xAA, 0x00, 0xAA, 0x00},
+  {0xAA, 0x44, 0xAA, 0x00, 0xAA, 0x44, 0xAA, 0x00},
+  {0xAA, 0x44, 0xAA, 0x11, 0xAA, 0x44, 0xAA, 0x11},
+  {0xAA, 0x55, 0xAA, 0x11, 0xAA, 0x55, 0xAA, 0x11},
+  {0xAA, 0x55, 0xAA, 0x55, 0xAA, 0x55, 0xAA, 0x55},   //50%, checkerboard
+  {0xEE, 0x55, 0xAA, 0x55, 0xEE, 0x55, 0xAA, 0x55},
+  {0xEE, 0x55, 0xBB, 0x55, 0xEE, 0x55, 0xBB, 0x55},
+  {0xFF, 0x55, 0xBB, 0x55, 0xFF, 0x55, 0xBB, 0x55},
+  {0xFF, 0x55, 0xFF, 0x55, 0xFF, 0x55, 0xFF, 0x55},
+  {0xFF, 0xDD, 0xFF, 0x55, 0xFF, 0xDD, 0xFF, 0x55},
+  {0xFF, 0xDD, 0xFF, 0x77, 0xFF, 0xDD, 0xFF, 0x77},
+  {0xFF, 0xFF, 0xFF, 0x77, 0xFF, 0xFF, 0xFF, 0x77},
+  {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF}
+};
+
+/**
+  *@brief fills a run of bits in a buffer
+  *@param buf ptr to buffer
+  *@param first index of the first bit
+  *@param last index of the last bit (inclusive)
+  *@param pattern mask applied to every byte of the run, 0xFF for solid. Must already be lined up with the buffer bytes
+  *@param val pixel value
+  */
+static void _span_bits(uint8_t* buf, uint32_t first, uint32_t last, uint8_t pattern, uint8_t val)
+{
+  uint8_t* p = &buf[first / 8];
+  uint8_t* end = &buf[last / 8];
+  uint8_t headMask = (0xFF >> (first % 8)) & pattern;
+  uint8_t tailMask = (0xFF << (7 - (last % 8))) & pattern;
+
+  //span fits in a single byte
+  if(p == end)
+  {
+    _apply(p, headMask & tailMask, val);
+    return;
+  }
+
+  _apply(p++, headMask, val);
+
+  //whole bytes in the middle
+  if(val == MONO_GFX_PIXEL_INVERT)
+  {
+    while(p < end)
+      *p++ ^= pattern;
+  }
+  else if(pattern == 0xFF)
+  {
+    memset(p, (val == MONO_GFX_PIXEL_OFF) ? 0x00 : 0xFF, end - p);
+  }
+  else if(val == MONO_GFX_PIXEL_OFF)
+  {
+    while(p < end)
+      *p++ &= ~pattern;
+  }
+  else
+  {
+    while(p < end)
+      *p++ |= pattern;
+  }
+
+  _apply(end, tailMask, val);
+}
+
+/**
+  *@brief lines a brush row up with the bytes of the buffer. Brushes are anchored to the canvas, so pixel x uses bit (x % 8)
+  *       of the row, but rows only start on a byte when the width is a multiple of 8
+  *@param row brush row for x = 0
+  *@param rowStart bit index of the first pixel of the row
+  *@return row rotated so bit n of each buffer byte gets the brush bit for its pixel
+  */
+static inline uint8_t _pattern_align(uint8_t row, uint32_t rowStart)
+{
+  int shift = rowStart % 8;
+
+  return (uint8_t)((row >> shift) | (row << (8 - shift)));
+}
+
+/**
+  *@brief fills the pixels of a horizontal span that a brush row covers
+  *@param gfx ptr to gfx canvas
+  *@param x0 first x coord of span
+  *@param x1 last x coord of span (inclusive)
+  *@param y y coord of row
+  *@param row brush row, msb is x = 0 (mod 8). 0xFF for solid
+  *@param val pixel value
+  */
+static void _span_pattern(mono_gfx_t* gfx, int x0, int x1, int y, uint8_t row, uint8_t val)
+{
+  if((y < 0) || (y >= gfx->mHeight) || (row == 0))
+    return;
+  if(x0 < 0)
+    x0 = 0;
+  if(x1 >= gfx->mWidth)
+    x1 = gfx->mWidth - 1;
+  if(x0 > x1)
+    return;
+
+  if(!gfx->mBuffered)
+  {
+    //write each run of covered pixels
+    while(x0 <= x1)
+    {
+      if(!(row & (0x80 >> (x0 % 8))))
+      {
+        x0++;
+        continue;
+      }
+
+      int end = x0;
+      while((end < x1) && (row & (0x80 >> ((end + 1) % 8))))
+        end++;
+
+      if(gfx->fWriteSpan != NULL)
+      {
+        gfx->fWriteSpan(gfx, x0, end, y, val);
+      }
+      else
+      {
+        for(int x = x0; x <= end; x++)
+          gfx->fWritePixel(gfx, x, y, val);
+      }
+      x0 = end + 1;
+    }
+    return;
+  }
+
+  uint32_t rowStart = y * gfx->mWidth;
+  _span_bits(gfx->mBuffer, rowStart + x0, rowStart + x1, _pattern_align(row, rowStart), val);
+}
+
+/**
+  *@brief fills a horizontal span of pixels on one row
+  *@param gfx ptr to gfx canvas
+  *@param x0 first x coord of span
+  *@param x1 last x coord of span (inclusive)
+  *@param y y coord of row
+  *@param val pixel value
+  */
+static inline void _span(mono_gfx_t* gfx, int x0, int x1, int y, uint8_t val)
+{
+  _span_pattern(gfx, x0, x1, y, 0xFF, val);
+}
+
+//gets the row of an 8x8 brush for canvas row y, NULL is a solid brush
+static inline uint8_t _brush_row(const uint8_t* pattern, int y)
+{
+  return (pattern != NULL) ? pattern[y & 7] : 0xFF;
+}
+
+/**
+  *@brief draws a run of bits onto one row. Only set bits are drawn, clear bits leave the canvas as is
+  *@param gfx ptr to gfx canvas
+  *@param x x coord of first bit
+  *@param y y coord of row
+  *@param src ptr to packed source bits (msb first)
+  *@param srcBit bit index in src to start from
+  *@param len number of bits to draw
+  *@param val pixel value
+  */
+static void _blit_bits(mono_gfx_t* gfx, int x, int y, const uint8_t* src, uint32_t srcBit, int len, uint8_t val)
+{
+  if((y < 0) || (y >= gfx->mHeight))
+    return;
+
+  //clip to canvas
+  if(x < 0)
+  {
+    srcBit -= x;
+    len += x;
+    x = 0;
+  }
+  if(x + len > gfx->mWidth)
+    len = gfx->mWidth - x;
+
+  if(!gfx->mBuffered)
+  {
+    for(int i=0; i < len; i++, srcBit++)
+    {
+      if(src[srcBit / 8] & (0x80 >> (srcBit % 8)))
+        gfx->fWritePixel(gfx, x + i, y, val);
+    }
+    return;
+  }
+
+  uint32_t dstBit = (y * gfx->mWidth) + x;
+
+  //move 8 bits at a time, realigning from the source bit offset to the destination bit offset
+  while(len > 0)
+  {
+    int n = (len < 8) ? len : 8;
+    uint8_t srcShift = srcBit % 8;
+    const uint8_t* s = &src[srcBit / 8];
+    uint8_t bits = s[0] << srcShift;
+
+    if(srcShift + n > 8)
+      bits |= s[1] >> (8 - srcShift);
+    bits &= 0xFF << (8 - n);
+
+    if(bits)
+    {
+      uint8_t dstShift = dstBit % 8;
+      uint8_t* d = &gfx->mBuffer[dstBit / 8];
+
+      _apply(d, bits >> dstShift, val);
+      if(dstShift + n > 8)
+        _apply(d + 1, bits << (8 - dstShift), val);
+    }
+
+    srcBit += n;
+    dstBit += n;
+    len -= n;
+  }
+}
+
+/**
+  *@brief draws a run of bits onto the canvas with each bit scaled up to a scale x scale block
+  *@param gfx ptr to gfx canvas
+  *@param x x coord of first bit
+  *@param y y coord of first row
+  *@param src ptr to packed source bits (msb first)
+  *@param srcBit bit index in src to start from
+  *@param len number of source bits to draw
+  *@param scale integer scale factor
+  *@param val pixel value
+  */
+static void _blit_bits_scaled(mono_gfx_t* gfx, int x, int y, const uint8_t* src, uint32_t srcBit, int len, int scale, uint8_t val)
+{
+  uint8_t spread[4];
+
+  if(scale <= 1)
+  {
+    _blit_bits(gfx, x, y, src, srcBit, len, val);
+    return;
+  }
+
+  //skip rows that are entirely off the canvas
+  if((y >= gfx->mHeight) || (y + scale <= 0))
+    return;
+
+  while(len > 0)
+  {
+    int n = (len < 8) ? len : 8;
+    uint8_t srcShift = srcBit % 8;
+    const uint8_t* s = &src[srcBit / 8];
+    uint8_t bits = s[0] << srcShift;
+
+    if(srcShift + n > 8)
+      bits |= s[1] >> (8 - srcShift);
+    bits &= 0xFF << (8 - n);
+
+    if(bits)
+    {
+      //spread the byte with the lookup tables, then write it as a span of bytes on each row
+      switch(scale)
+      {
+        case 2:
+          spread[0] = _spread2[bits >> 4];
+          spread[1] = _spread2[bits & 0x0F];
+          break;
+        case 3:
+        {
+          uint32_t wide = ((uint32_t)_spread3[bits >> 4] << 12) | _spread3[bits & 0x0F];
+          spread[0] = wide >> 16;
+          spread[1] = wide >> 8;
+          spread[2] = wide;
+          break;
+        }
+        case 4:
+          spread[0] = _spread4[bits >> 4] >> 8;
+          spread[1] = _spread4[bits >> 4];
+          spread[2] = _spread4[bits & 0x0F] >> 8;
+          spread[3] = _spread4[bits & 0x0F];
+          break;
+        default:
+          //larger scales are rare, draw each set bit as a block of spans
+          for(int b=0; b < n; b++)
+          {
+            if(bits & (0x80 >> b))
+            {
+              for(int r=0; r < scale; r++)
+                _span(gfx, x + (b * scale), x + (b * scale) + scale - 1, y + r, val);
+            }
+          }
+          break;
+      }
+
+      if(scale <= 4)
+      {
+        for(int r=0; r < scale; r++)
+          _blit_bits(gfx, x, y + r, spread, 0, n * scale, val);
+      }
+    }
+
+    x += n * scale;
+    srcBit += n;
+    len -= n;
+  }
+}
+
 mrt_status_t mono_gfx_init_buffered(mono_gfx_t* gfx, int width, int height)
 {
-  gfx->mBufferSize = (width * height)/8;
+  gfx->mBufferSize = ((width * height) + 7)/8;
   gfx->mBuffer = (uint8_t*) malloc(gfx->mBufferSize);
   memset(gfx->mBuffer,0,gfx->mBufferSize);
   gfx->mWidth = width;
   gfx->mHeight = height;
   gfx->mFont  = NULL;
+  gfx->mTextScale = 1;
+  gfx->mTextStyle = MONO_GFX_STYLE_NORMAL;
+  gfx->mTextRotation = MONO_GFX_ROTATE_0;
+  gfx->mTextCache = NULL;
+  gfx->mRotCache = NULL;
+  gfx->mFontChain = NULL;
   gfx->fWritePixel = &mono_gfx_write_pixel;
+  gfx->mPattern = NULL;
+  gfx->fWriteSpan = NULL;
   gfx->mDevice  = NULL;
   gfx->mBuffered = true;
 
@@ -40,12 +377,20 @@ mrt_status_t mono_gfx_init_buffered(mono_gfx_t* gfx, int width, int height)
 
 mrt_status_t mono_gfx_init_unbuffered(mono_gfx_t* gfx, int width, int height, f_mono_gfx_write_pixel write_cb, void* dev )
 {
-  gfx->mBufferSize = (width * height)/8;
+  gfx->mBufferSize = ((width * height) + 7)/8;
   gfx->mBuffer = NULL;
   gfx->mWidth = width;
   gfx->mHeight = height;
   gfx->mFont  = NULL;
+  gfx->mTextScale = 1;
+  gfx->mTextStyle = MONO_GFX_STYLE_NORMAL;
+  gfx->mTextRotation = MONO_GFX_ROTATE_0;
+  gfx->mTextCache = NULL;
+  gfx->mRotCache = NULL;
+  gfx->mFontChain = NULL;
   gfx->fWritePixel = write_cb;
+  gfx->mPattern = NULL;
+  gfx->fWriteSpan = NULL;
   gfx->mDevice  = dev;
   gfx->mBuffered = false;
 
@@ -72,20 +417,22 @@ mrt_status_t mono_gfx_write_pixel(mono_gfx_t* gfx, int x, int y, uint8_t val)
   if(( x < 0) || (x >= gfx->mWidth) || (y < 0) || (y>= gfx->mHeight))
     return MRT_STATUS_OK;
 
-    uint32_t cursor = (y * gfx->mWidth) + x;
-    uint8_t mask = 0x80;
+  uint32_t cursor = (y * gfx->mWidth) + x;
+  uint8_t mask = 0x80;
 
-    //get number of bits off of alignment in case we are not writing on a byte boundary
-    uint32_t byteOffset = (cursor  / 8);
-    uint8_t bitOffset = cursor % 8;
-    mask = mask >> bitOffset;
+  //get number of bits off of alignment in case we are not writing on a byte boundary
+  uint32_t byteOffset = (cursor  / 8);
+  uint8_t bitOffset = cursor % 8;
+  mask = mask >> bitOffset;
 
-    if( val == 0)
-      gfx->mBuffer[byteOffset] &= (~mask);
-    else
-      gfx->mBuffer[byteOffset] |= mask;
+  if( val == MONO_GFX_PIXEL_OFF)
+    gfx->mBuffer[byteOffset] &= (~mask);
+  else if( val == MONO_GFX_PIXEL_INVERT)
+    gfx->mBuffer[byteOffset] ^= mask;
+  else
+    gfx->mBuffer[byteOffset] |= mask;
 
-    return MRT_STATUS_OK;
+  return MRT_STATUS_OK;
 
 }
 
@@ -136,7 +483,7 @@ mrt_status_t mono_gfx_write_buffer(mono_gfx_t* gfx, int x, int y, uint8_t* data,
   cursor += len;
 
   // If its gone over, wrap
-  while(cursor >= (gfx->mWidth * gfx->mHeight))
+  while(cursor >= (uint32_t)(gfx->mWidth * gfx->mHeight))
     cursor -=  (gfx->mWidth * gfx->mHeight);
 
   return MRT_STATUS_OK;
@@ -145,135 +492,2711 @@ mrt_status_t mono_gfx_write_buffer(mono_gfx_t* gfx, int x, int y, uint8_t* data,
 
 mrt_status_t mono_gfx_draw_bmp(mono_gfx_t* gfx, int x, int y,const GFXBmp* bmp, uint8_t val)
 {
-  uint32_t bmpIdx = 0;
-  uint8_t mask =0x80;
-  int bit =0;
-  int i,a;
+  return mono_gfx_draw_bmp_scaled(gfx, x, y, bmp, 1, val);
+}
 
-  for(i=0; i < bmp->height; i ++)
-  {
-    for(a=0; a < bmp->width; a++)
-    {
-      if(((bmp->data[bmpIdx/8] << bit) & mask))
-        gfx->fWritePixel(gfx, x+a, y+i, val);
-      bmpIdx ++;
-      bit++;
-      if(bit == 8)
-        bit =0;
-    }
+mrt_status_t mono_gfx_draw_bmp_scaled(mono_gfx_t* gfx, int x, int y,const GFXBmp* bmp, int scale, uint8_t val)
+{
+  if(scale < 1)
+    return MRT_STATUS_ERROR;
 
+  //bitmap rows are packed back to back, so row i starts at bit i*width
+  for(int i=0; i < bmp->height; i ++)
+  {
+    _blit_bits_scaled(gfx, x, y + (i * scale), bmp->data, (uint32_t)i * bmp->width, bmp->width, scale, val);
   }
   return MRT_STATUS_OK;
 }
 
 
-mrt_status_t mono_gfx_print(mono_gfx_t* gfx, int x, int y, const char * text, uint8_t val)
+uint32_t mono_gfx_utf8_next(const char** text)
 {
+  const uint8_t* s = (const uint8_t*) *text;
+  uint32_t cp;
+  int extra;
 
-  //if a font has not been set, return error
-  if(gfx->mFont == NULL)
-    return MRT_STATUS_ERROR;
+  if(*s == 0)
+    return 0;
 
-  int xx =x;     //current position for writing
-  int yy = y;
-  GFXglyph* glyph;    //pointer to glyph for current character
-  GFXBmp bmp;         //bitmap struct used to draw glyph
-  char c = *text++;   //grab first character from string
+  //determine sequence length from the lead byte
+  if(*s < 0x80)
+  {
+    *text = (const char*)(s + 1);
+    return *s;
+  }
+  else if((*s & 0xE0) == 0xC0)
+  {
+    cp = *s & 0x1F;
+    extra = 1;
+  }
+  else if((*s & 0xF0) == 0xE0)
+  {
+    cp = *s & 0x0F;
+    extra = 2;
+  }
+  else if((*s & 0xF8) == 0xF0)
+  {
+    cp = *s & 0x07;
+    extra = 3;
+  }
+  else
+  {
+    //stray continuation byte or invalid lead byte, skip it
+    *text = (const char*)(s + 1);
+    return 0xFFFD;
+  }
 
-  //run until we hit a null character (end of string)
-  while(c != 0)
+  for(int i=1; i <= extra; i++)
   {
-    if(c == '\n')
+    //truncated sequence, only consume what was valid so the next byte gets decoded on its own
+    if((s[i] & 0xC0) != 0x80)
     {
-      //if character is newline, we advance the y, and reset x
-      yy+= gfx->mFont->yAdvance;
-      xx = x;
+      *text = (const char*)(s + i);
+      return 0xFFFD;
     }
-    else if((c >= gfx->mFont->first) && (c <= gfx->mFont->last))// make sure the font contains this character
-    {
-      //grab the glyph for current character from our font
-      glyph = &gfx->mFont->glyph[c - gfx->mFont->first]; //index in glyph array is offset by first printable char in font
+    cp = (cp << 6) | (s[i] & 0x3F);
+  }
+  *text = (const char*)(s + extra + 1);
 
-      //map glyph to a bitmap that we can draw
-      bmp.data = &gfx->mFont->bitmap[glyph->bitmapOffset];
-      bmp.width = glyph->width ;
-      bmp.height = glyph->height ;
+  //reject overlong encodings, surrogates, and out of range values
+  if( ((extra == 1) && (cp < 0x80)) || ((extra == 2) && (cp < 0x800)) || ((extra == 3) && (cp < 0x10000)) ||
+      ((cp >= 0xD800) && (cp <= 0xDFFF)) || (cp > 0x10FFFF))
+    return 0xFFFD;
 
-      //draw the character
-      mono_gfx_draw_bmp(gfx, xx+glyph->xOffset , yy+ glyph->yOffset , &bmp,val );
-      xx += glyph->xOffset + glyph->xAdvance;
-    }
+  return cp;
+}
+
+const GFXglyph* mono_gfx_get_glyph(const GFXfont* font, uint32_t codepoint)
+{
+  //most text is in the primary block, so check it first
+  if((codepoint >= font->first) && (codepoint <= font->last))
+    return &font->glyph[codepoint - font->first]; //index in glyph array is offset by first printable char in font
 
+  //binary search the extra ranges
+  int lo = 0;
+  int hi = (int)font->rangeCount - 1;
+  while((font->ranges != NULL) && (lo <= hi))
+  {
+    int mid = (lo + hi) / 2;
+    const GFXrange* range = &font->ranges[mid];
 
-    //get next character
-    c = *text++;
+    if(codepoint < range->first)
+      hi = mid - 1;
+    else if(codepoint > range->last)
+      lo = mid + 1;
+    else
+      return &font->glyph[range->glyphIndex + (codepoint - range->first)];
   }
 
-  return MRT_STATUS_OK;
+  return NULL;
 }
 
-mrt_status_t mono_gfx_draw_line(mono_gfx_t* gfx, int x0, int y0, int x1, int y1, uint8_t val)
+int mono_gfx_get_kerning(const GFXfont* font, const GFXglyph* left, const GFXglyph* right)
 {
-  int16_t steep = abs(y1 - y0) > abs(x1 - x0);
-  int swap;
-  if (steep) {
-      _swap_int(x0, y0);
-      _swap_int(x1, y1);
+  const GFXkern* kern = font->kern;
+  if((kern == NULL) || (left == NULL))
+    return 0;
+
+  uint16_t l = left - font->glyph;
+  uint16_t r = right - font->glyph;
+  if(l >= kern->glyphCount)
+    return 0;
+
+  //pairs for the left glyph are a sorted run, binary search it for the right glyph
+  int lo = kern->index[l];
+  int hi = kern->index[l+1] - 1;
+  while(lo <= hi)
+  {
+    int mid = (lo + hi) / 2;
+    if(r < kern->pairs[mid].second)
+      hi = mid - 1;
+    else if(r > kern->pairs[mid].second)
+      lo = mid + 1;
+    else
+      return kern->pairs[mid].xAdjust;
   }
 
-  if (x0 > x1) {
-      _swap_int(x0, x1);
-      _swap_int(y0, y1);
+  return 0;
+}
+
+void mono_gfx_font_chain_init(GFXfontChain* chain, const GFXfont* const* fonts, uint8_t count)
+{
+  memset(chain, 0, sizeof(GFXfontChain));
+  chain->fonts = fonts;
+  chain->count = count;
+}
+
+const GFXglyph* mono_gfx_font_chain_get_glyph(GFXfontChain* chain, const GFXfont* primary, uint32_t codepoint, const GFXfont** font)
+{
+  GFXchainSlot* slot = &chain->cache[codepoint & (MONO_GFX_CHAIN_CACHE_SIZE - 1)];
+  const GFXglyph* glyph;
+
+  //cached results are only good for the primary font they were found with
+  if(chain->primary != primary)
+  {
+    memset(chain->cache, 0, sizeof(chain->cache));
+    chain->primary = primary;
   }
 
-  int16_t dx, dy;
-  dx = x1 - x0;
-  dy = abs(y1 - y0);
+  if((slot->codepoint == codepoint) && (codepoint != 0))
+  {
+    chain->hits++;
+    *font = slot->font;
+    return slot->glyph;
+  }
 
-  int16_t err = dx / 2;
-  int16_t ystep;
+  chain->misses++;
+  *font = primary;
+  glyph = mono_gfx_get_glyph(primary, codepoint);
 
-  if (y0 < y1) {
-      ystep = 1;
-  } else {
-      ystep = -1;
+  for(int i=0; (glyph == NULL) && (i < chain->count); i++)
+  {
+    *font = chain->fonts[i];
+    glyph = mono_gfx_get_glyph(*font, codepoint);
   }
 
-  for (; x0<=x1; x0++) {
-      if (steep) {
-          gfx->fWritePixel(gfx,y0, x0, val);
-      } else {
-          gfx->fWritePixel(gfx, x0, y0, val);
-      }
-      err -= dy;
-      if (err < 0) {
-          y0 += ystep;
-          err += dx;
-      }
+  //characters that no font has are cached too, so they dont search the whole chain every time
+  if(glyph == NULL)
+    *font = NULL;
+
+  slot->codepoint = codepoint;
+  slot->font = *font;
+  slot->glyph = glyph;
+
+  return glyph;
+}
+
+//writes a pixel through the canvas write function if it is on the canvas
+static inline void _plot(mono_gfx_t* gfx, int x, int y, uint8_t val)
+{
+  if((x >= 0) && (x < gfx->mWidth) && (y >= 0) && (y < gfx->mHeight))
+    gfx->fWritePixel(gfx, x, y, val);
+}
+
+/**
+  *@brief copies a run of bits onto a byte boundary, clearing any unused bits in the last byte
+  *@param src ptr to packed source bits
+  *@param srcBit bit index in src to start from
+  *@param len number of bits
+  *@param dst ptr to store bits
+  */
+static void _read_bits(const uint8_t* src, uint32_t srcBit, int len, uint8_t* dst)
+{
+  for(int i=0; i < len; i += 8)
+  {
+    uint32_t b = srcBit + i;
+    uint8_t bits = src[b / 8] << (b % 8);
+    if((b % 8) + ((len - i < 8) ? (len - i) : 8) > 8)
+      bits |= src[(b / 8) + 1] >> (8 - (b % 8));
+    dst[i / 8] = bits;
   }
-  //TODO implement
-  return MRT_STATUS_OK;
+  if(len % 8)
+    dst[(len - 1) / 8] &= 0xFF << (8 - (len % 8));
 }
 
-mrt_status_t mono_gfx_draw_rect(mono_gfx_t* gfx, int x, int y, int w, int h,  uint8_t val)
+//shear for synthetic oblique, 1/4 pixel per row pivoting on the baseline so descenders lean the other way
+static inline int _oblique_shift(const GFXglyph* glyph, int r)
+{
+  int above = -(glyph->yOffset + r) - 1;
+  return (above >= 0) ? (above / 4) : -((3 - above) / 4);
+}
+
+//smears an aligned row one pixel to the right for synthetic bold. Row must have room for len + 1 bits
+static void _bold_row(uint8_t* row, int len)
+{
+  for(int i = len / 8; i >= 0; i--)
+    row[i] |= (row[i] >> 1) | ((i > 0) ? (uint8_t)(row[i-1] << 7) : 0);
+}
+
+#ifndef MONO_GFX_FIXED_BATCH
+#define MONO_GFX_FIXED_BATCH 64           //glyphs drawn together by the fixed advance print path
+#endif
+
+#ifndef MONO_GFX_NUM_MAX_CHARS
+#define MONO_GFX_NUM_MAX_CHARS 24         //longest number mono_gfx_print_fixed will draw, including padding
+#endif
+
+static const char _numChars[] = "0123456789-+.";
+#define MONO_GFX_NUM_SYM_MINUS 10         //index of sign and point in _numChars
+#define MONO_GFX_NUM_SYM_PLUS 11
+#define MONO_GFX_NUM_SYM_POINT 12
+#define MONO_GFX_NUM_SYM_SPACE 13         //padding, advances like a digit but draws nothing
+
+/**
+  *@brief gets the bitmap of a glyph, reading it through the font's pager if it has one
+  *@return ptr to bitmap (only valid until the next glyph is fetched), or NULL if it could not be read
+  */
+static inline const uint8_t* _glyph_bits(const GFXfont* font, const GFXglyph* glyph)
+{
+  if(font->pager != NULL)
+    return mono_gfx_font_pager_get(font->pager, glyph->bitmapOffset, (((uint32_t)glyph->width * glyph->height) + 7) / 8);
+
+  return &font->bitmap[glyph->bitmapOffset];
+}
+
+void mono_gfx_flush_glyph_cache(mono_gfx_t* gfx)
+{
+  if(gfx->mRotCache != NULL)
+  {
+    for(int i=0; i < MONO_GFX_ROT_CACHE_ENTRIES; i++)
+      gfx->mRotCache->mEntries[i].glyph = NULL;
+  }
+
+  if(gfx->mTextCache != NULL)
+    mono_gfx_text_cache_clear(gfx->mTextCache);
+}
+
+/**
+  *@brief transposes an 8x8 block of bits (Hacker's Delight 7-3)
+  *@param src ptr to first row of block
+  *@param srcStride bytes between rows of src
+  *@param dst ptr to first row of output block
+  *@param dstStride bytes between rows of dst
+  */
+static void _transpose8(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride)
+{
+  uint64_t x = 0;
+  uint64_t t;
+
+  for(int i=0; i < 8; i++)
+    x = (x << 8) | src[i * srcStride];
+
+  t = (x ^ (x >> 7)) & 0x00AA00AA00AA00AAULL;
+  x = x ^ t ^ (t << 7);
+  t = (x ^ (x >> 14)) & 0x0000CCCC0000CCCCULL;
+  x = x ^ t ^ (t << 14);
+  t = (x ^ (x >> 28)) & 0x00000000F0F0F0F0ULL;
+  x = x ^ t ^ (t << 28);
+
+  for(int i=7; i >= 0; i--)
+  {
+    dst[i * dstStride] = x;
+    x >>= 8;
+  }
+}
+
+//reverses the bits of a byte
+static inline uint8_t _reverse8(uint8_t b)
+{
+  b = (b >> 4) | (b << 4);
+  b = ((b & 0xCC) >> 2) | ((b & 0x33) << 2);
+  return ((b & 0xAA) >> 1) | ((b & 0x55) << 1);
+}
+
+/**
+  *@brief gets a rotated copy of a glyph from the cache, building it if needed
+  *@param cache ptr to rotated glyph cache
+  *@return ptr to cache entry, or NULL if the glyph is too big to cache
+  */
+static const mono_gfx_rot_entry_t* _rotated_glyph(mono_gfx_rot_cache_t* cache, const GFXfont* font, const GFXglyph* glyph, uint8_t rotation, uint8_t style)
 {
-  for(int i=0; i < h; i++)
+  //consecutive glyphs land in different sets, so a run of text only collides once it uses more glyphs than there are sets
+  uint32_t set = ((uint32_t)(glyph - font->glyph) + rotation) % (MONO_GFX_ROT_CACHE_ENTRIES / 2);
+  mono_gfx_rot_entry_t* entry = &cache->mEntries[set * 2];
+  const uint8_t* bits;
+  int bold = (style & MONO_GFX_STYLE_BOLD) ? 1 : 0;
+  int minShift = 0;
+  int maxShift = 0;
+
+  for(int way=0; way < 2; way++)
   {
-    for(int a=0; a < w; a++)
+    if((entry[way].glyph == glyph) && (entry[way].rotation == rotation) && (entry[way].style == style))
     {
-      gfx->fWritePixel(gfx,x+a, y+i, val);
+      cache->mLast[set] = way;
+      return &entry[way];
     }
   }
 
-  return MRT_STATUS_OK;
+  //replace the least recently used way
+  entry = &entry[cache->mLast[set] ^ 1];
+
+  if((style & MONO_GFX_STYLE_OBLIQUE) && (glyph->height > 0))
+  {
+    maxShift = _oblique_shift(glyph, 0);
+    minShift = _oblique_shift(glyph, glyph->height - 1);
+  }
+
+  //upright styled image, padded out to whole 8x8 blocks
+  int w = glyph->width + bold + (maxShift - minShift);
+  int h = glyph->height;
+  int wPad = (w + 7) & ~7;
+  int hPad = (h + 7) & ~7;
+  uint8_t img[MONO_GFX_ROT_GLYPH_BYTES];
+  uint8_t row[(255 + 1 + 7) / 8 + 1];
+
+  if((wPad * hPad / 8) > MONO_GFX_ROT_GLYPH_BYTES)
+    return NULL;
+
+  bits = _glyph_bits(font, glyph);
+  if(bits == NULL)
+    return NULL;
+
+  memset(img, 0, wPad * hPad / 8);
+  for(int r=0; r < h; r++)
+  {
+    int shift = (style & MONO_GFX_STYLE_OBLIQUE) ? _oblique_shift(glyph, r) - minShift : 0;
+    int len = glyph->width;
+
+    memset(row, 0, sizeof(row));
+    _read_bits(bits, (uint32_t)r * glyph->width, len, row);
+    if(bold)
+    {
+      _bold_row(row, len);
+      len++;
+    }
+
+    //for 90 degrees the rows are flipped before transposing
+    uint8_t* dst = &img[((rotation == MONO_GFX_ROTATE_90) ? (h - 1 - r) : r) * (wPad / 8)];
+    for(int i=0; i < (len + 7) / 8; i++)
+    {
+      dst[(shift / 8) + i] |= row[i] >> (shift % 8);
+      if((shift % 8) && ((shift / 8) + i + 1 < wPad / 8))
+        dst[(shift / 8) + i + 1] |= row[i] << (8 - (shift % 8));
+    }
+  }
+
+  if(rotation == MONO_GFX_ROTATE_180)
+  {
+    //reverse the row order and the bits in each row, then line the image back up with the left edge
+    int stride = wPad / 8;
+    int pad = wPad - w;
+    for(int r=0; r < h; r++)
+    {
+      const uint8_t* src = &img[(h - 1 - r) * stride];
+      uint8_t* dst = &entry->data[r * stride];
+      for(int i=0; i < stride; i++)
+      {
+        uint8_t hi = _reverse8(src[stride - 1 - i]);
+        uint8_t lo = (i + 1 < stride) ? _reverse8(src[stride - 2 - i]) : 0;
+        dst[i] = pad ? (uint8_t)((hi << pad) | (lo >> (8 - pad))) : hi;
+      }
+    }
+  }
+  else
+  {
+    //transpose block by block. Image is w columns by h rows, output is h columns by w rows
+    int srcStride = wPad / 8;
+    int dstStride = hPad / 8;
+    for(int by=0; by < hPad / 8; by++)
+    {
+      for(int bx=0; bx < srcStride; bx++)
+      {
+        _transpose8(&img[(by * 8 * srcStride) + bx], srcStride, &entry->data[(bx * 8 * dstStride) + by], dstStride);
+      }
+    }
+
+    //for 270 degrees the rows are flipped after transposing
+    if(rotation == MONO_GFX_ROTATE_270)
+    {
+      uint8_t tmp[MONO_GFX_ROT_GLYPH_BYTES / 8];
+      for(int r=0; r < w / 2; r++)
+      {
+        memcpy(tmp, &entry->data[r * dstStride], dstStride);
+        memcpy(&entry->data[r * dstStride], &entry->data[(w - 1 - r) * dstStride], dstStride);
+        memcpy(&entry->data[(w - 1 - r) * dstStride], tmp, dstStride);
+      }
+    }
+  }
+
+  cache->mLast[set] = (entry - cache->mEntries) & 1;
+  entry->glyph = glyph;
+  entry->rotation = rotation;
+  entry->style = style;
+  entry->width = w;
+  entry->height = h;
+  entry->minShift = minShift;
+  return entry;
 }
 
+/**
+  *@brief draws a glyph with the current text scale, style, and rotation
+  *@param gfx ptr to gfx canvas
+  *@param font font that the glyph belongs to
+  *@param glyph ptr to glyph
+  *@param x pen x
+  *@param y pen y (baseline)
+  *@param val pixel value
+  */
+static void _draw_glyph(mono_gfx_t* gfx, const GFXfont* font, const GFXglyph* glyph, int x, int y, uint8_t val)
+{
+  const uint8_t* bits;
+  int scale = (gfx->mTextScale > 1) ? gfx->mTextScale : 1;
+  uint8_t style = gfx->mTextStyle;
+  int w = glyph->width;
+  uint8_t row[(255 + 1 + 7) / 8]; //widest glyph row plus the bold smear
+
+  if(gfx->mTextRotation != MONO_GFX_ROTATE_0)
+  {
+    const mono_gfx_rot_entry_t* rot = (gfx->mRotCache != NULL) ? _rotated_glyph(gfx->mRotCache, font, glyph, gfx->mTextRotation, style) : NULL;
+
+    if(rot != NULL)
+    {
+      //ink box of the upright glyph relative to the pen, u along the text and v down
+      int u0 = (glyph->xOffset + rot->minShift) * scale;
+      int v0 = glyph->yOffset * scale;
+      int uw = rot->width * scale;
+      int vh = rot->height * scale;
+      int left, top, rowLen, rows, stride;
+
+      switch(gfx->mTextRotation)
+      {
+        case MONO_GFX_ROTATE_90:
+          left = x - (v0 + vh) + 1;
+          top = y + u0;
+          rowLen = rot->height;
+          rows = rot->width;
+          break;
+        case MONO_GFX_ROTATE_180:
+          left = x - (u0 + uw) + 1;
+          top = y - (v0 + vh) + 1;
+          rowLen = rot->width;
+          rows = rot->height;
+          break;
+        default: //270
+          left = x + v0;
+          top = y - (u0 + uw) + 1;
+          rowLen = rot->height;
+          rows = rot->width;
+          break;
+      }
+
+      stride = (rowLen + 7) / 8;
+      for(int r=0; r < rows; r++)
+        _blit_bits_scaled(gfx, left, top + (r * scale), &rot->data[r * stride], 0, rowLen, scale, val);
+      return;
+    }
+
+    //no cache or too big to cache, rotate each pixel
+    bits = _glyph_bits(font, glyph);
+    if(bits == NULL)
+      return;
+
+    for(int r=0; r < glyph->height; r++)
+    {
+      int shift = (style & MONO_GFX_STYLE_OBLIQUE) ? _oblique_shift(glyph, r) : 0;
+      int len = w;
+
+      memset(row, 0, sizeof(row));
+      _read_bits(bits, (uint32_t)r * w, w, row);
+      if(style & MONO_GFX_STYLE_BOLD)
+      {
+        _bold_row(row, len);
+        len++;
+      }
+
+      for(int i=0; i < len; i++)
+      {
+        if(!(row[i / 8] & (0x80 >> (i % 8))))
+          continue;
+
+        int u = (glyph->xOffset + shift + i) * scale;
+        int v = (glyph->yOffset + r) * scale;
+        for(int su=0; su < scale; su++)
+        {
+          for(int sv=0; sv < scale; sv++)
+          {
+            if(gfx->mTextRotation == MONO_GFX_ROTATE_90)
+              _plot(gfx, x - (v + sv), y + (u + su), val);
+            else if(gfx->mTextRotation == MONO_GFX_ROTATE_180)
+              _plot(gfx, x - (u + su), y - (v + sv), val);
+            else
+              _plot(gfx, x + (v + sv), y - (u + su), val);
+          }
+        }
+      }
+    }
+    return;
+  }
+
+  bits = _glyph_bits(font, glyph);
+  if(bits == NULL)
+    return;
+
+  x += glyph->xOffset * scale;
+  y += glyph->yOffset * scale;
+
+  for(int r=0; r < glyph->height; r++, y += scale)
+  {
+    if(style == MONO_GFX_STYLE_NORMAL)
+    {
+      //draw straight out of the font
+      _blit_bits_scaled(gfx, x, y, bits, (uint32_t)r * w, w, scale, val);
+      continue;
+    }
+
+    const uint8_t* src = bits;
+    uint32_t srcBit = (uint32_t)r * w;
+    int len = w;
+    int shift = 0;
+
+    if(style & MONO_GFX_STYLE_BOLD)
+    {
+      //pull the row out onto a byte boundary, then OR it with itself shifted right by one pixel
+      memset(row, 0, sizeof(row));
+      _read_bits(bits, srcBit, w, row);
+      _bold_row(row, w);
+
+      src = row;
+      srcBit = 0;
+      len = w + 1;
+    }
+
+    if(style & MONO_GFX_STYLE_OBLIQUE)
+      shift = _oblique_shift(glyph, r);
+
+    _blit_bits_scaled(gfx, x + (shift * scale), y, src, srcBit, len, scale, val);
+  }
+}
+
+mrt_status_t mono_gfx_draw_glyph(mono_gfx_t* gfx, const GFXfont* font, const GFXglyph* glyph, int x, int y, uint8_t val)
+{
+  _draw_glyph(gfx, font, glyph, x, y, val);
+  return MRT_STATUS_OK;
+}
+
+/**
+  *@brief state for walking the glyphs of a string
+  */
+typedef struct{
+  const char* text;       //remaining text
+  const GFXfont* font;    //font being laid out
+  GFXfontChain* chain;    //fallback fonts (NULL for none)
+  const GFXfont* glyphFont; //font of the last glyph returned
+  const GFXglyph* prev;   //previous glyph on the line (for kerning)
+  const GFXfont* prevFont;
+  int scale;              //integer scale factor
+  int bold;               //extra advance for synthetic bold
+  int x0;                 //x to return to on newline
+  int x;                  //pen position
+  int y;
+}mono_gfx_cursor_t;
+
+static void _cursor_init(mono_gfx_cursor_t* cur, mono_gfx_t* gfx, int x, int y, const char* text)
+{
+  cur->text = text;
+  cur->font = gfx->mFont;
+  cur->chain = gfx->mFontChain;
+  cur->glyphFont = gfx->mFont;
+  cur->prev = NULL;
+  cur->prevFont = NULL;
+  cur->scale = (gfx->mTextScale > 1) ? gfx->mTextScale : 1;
+  cur->bold = (gfx->mTextStyle & MONO_GFX_STYLE_BOLD) ? 1 : 0;
+  cur->x0 = x;
+  cur->x = x;
+  cur->y = y;
+}
+
+/**
+  *@brief gets the next drawable glyph in the string and advances the pen past it
+  *@param cur ptr to cursor
+  *@param gx ptr to store pen x of glyph
+  *@param gy ptr to store pen y (baseline) of glyph
+  *@return ptr to glyph (from the font in cur->glyphFont), or NULL at end of string
+  */
+static const GFXglyph* _cursor_next(mono_gfx_cursor_t* cur, int* gx, int* gy)
+{
+  const GFXglyph* glyph;
+  uint32_t c;
+
+  while((c = mono_gfx_utf8_next(&cur->text)) != 0)
+  {
+    if(c == '\n')
+    {
+      //if character is newline, we advance the y, and reset x
+      cur->y += cur->font->yAdvance * cur->scale;
+      cur->x = cur->x0;
+      cur->prev = NULL;
+    }
+    else
+    {
+      if(cur->chain != NULL)
+        glyph = mono_gfx_font_chain_get_glyph(cur->chain, cur->font, c, &cur->glyphFont);
+      else
+        glyph = mono_gfx_get_glyph(cur->font, c);
+
+      // make sure the font contains this character
+      if(glyph == NULL)
+        continue;
+
+      //pairs are only kerned within one font
+      if(cur->prevFont == cur->glyphFont)
+        cur->x += mono_gfx_get_kerning(cur->glyphFont, cur->prev, glyph) * cur->scale;
+      *gx = cur->x;
+      *gy = cur->y;
+      //xOffset only places the glyph, the pen moves by xAdvance alone (as in Adafruit GFX)
+      cur->x += (glyph->xAdvance + cur->bold) * cur->scale;
+      cur->prev = glyph;
+      cur->prevFont = cur->glyphFont;
+      return glyph;
+    }
+  }
+
+  return NULL;
+}
+
+/**
+  *@brief draws a glyph at a pen position given along the direction of the text
+  *@param gfx ptr to gfx canvas
+  *@param font font that the glyph belongs to
+  *@param glyph ptr to glyph
+  *@param x x coord of text origin
+  *@param y y coord of text origin
+  *@param u pen distance along the text from the origin
+  *@param v pen distance down from the origin
+  *@param val pixel value
+  */
+static void _draw_glyph_at(mono_gfx_t* gfx, const GFXfont* font, const GFXglyph* glyph, int x, int y, int u, int v, uint8_t val)
+{
+  //turn the pen position to match the text rotation
+  switch(gfx->mTextRotation)
+  {
+    case MONO_GFX_ROTATE_90:
+      _draw_glyph(gfx, font, glyph, x - v, y + u, val);
+      break;
+    case MONO_GFX_ROTATE_180:
+      _draw_glyph(gfx, font, glyph, x - u, y - v, val);
+      break;
+    case MONO_GFX_ROTATE_270:
+      _draw_glyph(gfx, font, glyph, x + v, y - u, val);
+      break;
+    default:
+      _draw_glyph(gfx, font, glyph, x + u, y + v, val);
+      break;
+  }
+}
+
+int mono_gfx_fixed_advance(const GFXfont* font)
+{
+  //fonts with a cache only scan once
+  if((font->cache == NULL) || !(font->cache->flags & MONO_GFX_FONT_CACHE_ADVANCE))
+  {
+    int advance = -1;
+
+    for(int i=0; (i <= font->last - font->first) && (advance != 0); i++)
+    {
+      if(advance < 0)
+        advance = font->glyph[i].xAdvance;
+      else if(font->glyph[i].xAdvance != advance)
+        advance = 0;
+    }
+
+    for(int r=0; (r < font->rangeCount) && (advance != 0); r++)
+    {
+      for(uint32_t i=0; (i <= font->ranges[r].last - font->ranges[r].first) && (advance != 0); i++)
+      {
+        const GFXglyph* glyph = &font->glyph[font->ranges[r].glyphIndex + i];
+        if(advance < 0)
+          advance = glyph->xAdvance;
+        else if(glyph->xAdvance != advance)
+          advance = 0;
+      }
+    }
+
+    //kerning moves glyphs off the grid
+    if((advance < 0) || (font->kern != NULL))
+      advance = 0;
+
+    if(font->cache == NULL)
+      return advance;
+
+    font->cache->fixedAdvance = advance;
+    font->cache->flags |= MONO_GFX_FONT_CACHE_ADVANCE;
+  }
+
+  return font->cache->fixedAdvance;
+}
+
+/**
+  *@brief draws one line of glyphs from a fixed advance font a row at a time, so each row of the canvas is only visited once
+  *@param gfx ptr to gfx canvas (must be buffered)
+  *@param font font that the glyphs belong to
+  *@param glyphs glyphs to draw, glyph k is drawn at x + k*advance
+  *@param count number of glyphs
+  *@param x pen x of first glyph
+  *@param y baseline
+  *@param advance fixed advance of the font
+  *@param val pixel value
+  */
+static void _draw_fixed_line(mono_gfx_t* gfx, const GFXfont* font, const GFXglyph** glyphs, int count, int x, int y, int advance, uint8_t val)
+{
+  int top = INT_MAX;
+  int bottom = INT_MIN;
+
+  for(int k=0; k < count; k++)
+  {
+    if(glyphs[k]->yOffset < top)
+      top = glyphs[k]->yOffset;
+    if(glyphs[k]->yOffset + glyphs[k]->height > bottom)
+      bottom = glyphs[k]->yOffset + glyphs[k]->height;
+  }
+
+  //clip the rows to the canvas
+  if(y + top < 0)
+    top = -y;
+  if(y + bottom > gfx->mHeight)
+    bottom = gfx->mHeight - y;
+
+  for(int r = top; r < bottom; r++)
+  {
+    for(int k=0; k < count; k++)
+    {
+      const GFXglyph* glyph = glyphs[k];
+      int row = r - glyph->yOffset;
+
+      if((row < 0) || (row >= glyph->height) || (glyph->width == 0))
+        continue;
+
+      _blit_bits(gfx, x + (k * advance) + glyph->xOffset, y + r, font->bitmap, ((uint32_t)glyph->bitmapOffset * 8) + (row * glyph->width), glyph->width, val);
+    }
+  }
+}
+
+/**
+  *@brief prints text in a fixed advance font. Glyph positions are just index math, so each line is drawn row by row across all of its glyphs
+  */
+static void _print_fixed(mono_gfx_t* gfx, int x, int y, const char * text, int advance, uint8_t val)
+{
+  const GFXfont* font = gfx->mFont;
+  const GFXglyph* glyphs[MONO_GFX_FIXED_BATCH];
+  const GFXglyph* glyph;
+  int count = 0;
+  int pen = x;
+  uint32_t c;
+
+  while((c = mono_gfx_utf8_next(&text)) != 0)
+  {
+    if(c == '\n')
+    {
+      _draw_fixed_line(gfx, font, glyphs, count, pen, y, advance, val);
+      count = 0;
+      pen = x;
+      y += font->yAdvance;
+    }
+    else if((glyph = mono_gfx_get_glyph(font, c)) != NULL)
+    {
+      glyphs[count++] = glyph;
+      if(count == MONO_GFX_FIXED_BATCH)
+      {
+        _draw_fixed_line(gfx, font, glyphs, count, pen, y, advance, val);
+        pen += count * advance;
+        count = 0;
+      }
+    }
+  }
+
+  _draw_fixed_line(gfx, font, glyphs, count, pen, y, advance, val);
+}
+
+mrt_status_t mono_gfx_print(mono_gfx_t* gfx, int x, int y, const char * text, uint8_t val)
+{
+  int advance;
+
+  //if a font has not been set, return error
+  if(gfx->mFont == NULL)
+    return MRT_STATUS_ERROR;
+
+  //blit the whole string from the cache if there is one
+  if((gfx->mTextCache != NULL) && (mono_gfx_text_cache_print(gfx->mTextCache, gfx, x, y, text, val) == MRT_STATUS_OK))
+    return MRT_STATUS_OK;
+
+  //plain upright text in a fixed advance font can skip the cursor and be drawn a row at a time.
+  //Paged fonts are left out, since that would need the bitmap of every glyph on the line at once
+  if( gfx->mBuffered && (gfx->mTextScale <= 1) && (gfx->mTextStyle == MONO_GFX_STYLE_NORMAL) &&
+      (gfx->mTextRotation == MONO_GFX_ROTATE_0) && (gfx->mFont->pager == NULL) && (gfx->mFontChain == NULL) &&
+      ((advance = mono_gfx_fixed_advance(gfx->mFont)) != 0) )
+  {
+    _print_fixed(gfx, x, y, text, advance, val);
+    return MRT_STATUS_OK;
+  }
+
+  mono_gfx_cursor_t cur;
+  const GFXglyph* glyph;    //pointer to glyph for current character
+  int xx, yy;         //pen position of current glyph, relative to x,y along the direction of the text
+
+  _cursor_init(&cur, gfx, 0, 0, text);
+
+  //run until we hit the end of the string
+  while((glyph = _cursor_next(&cur, &xx, &yy)) != NULL)
+  {
+    //draw the character
+    _draw_glyph_at(gfx, cur.glyphFont, glyph, x, y, xx, yy, val);
+  }
+
+  return MRT_STATUS_OK;
+}
+
+//grows a bounding box (x0,y0,x1,y1) by the ink of a glyph drawn at pen position xx,yy
+static void _grow_bounds(mono_gfx_cursor_t* cur, uint8_t style, const GFXglyph* glyph, int xx, int yy, int* box, bool* empty)
+{
+  if((glyph->width == 0) || (glyph->height == 0))
+    return;
+
+  int x0 = xx + (glyph->xOffset * cur->scale);
+  int y0 = yy + (glyph->yOffset * cur->scale);
+  int x1 = x0 + ((glyph->width + cur->bold) * cur->scale);
+  int y1 = y0 + (glyph->height * cur->scale);
+
+  if(style & MONO_GFX_STYLE_OBLIQUE)
+  {
+    x0 += _oblique_shift(glyph, glyph->height - 1) * cur->scale;
+    x1 += _oblique_shift(glyph, 0) * cur->scale;
+  }
+
+  if(*empty || (x0 < box[0]))
+    box[0] = x0;
+  if(*empty || (y0 < box[1]))
+    box[1] = y0;
+  if(*empty || (x1 > box[2]))
+    box[2] = x1;
+  if(*empty || (y1 > box[3]))
+    box[3] = y1;
+  *empty = false;
+}
+
+mrt_status_t mono_gfx_text_bounds(mono_gfx_t* gfx, const char * text, GFXrect* rect)
+{
+  //if a font has not been set, return error
+  if(gfx->mFont == NULL)
+    return MRT_STATUS_ERROR;
+
+  mono_gfx_cursor_t cur;
+  const GFXglyph* glyph;
+  int xx, yy;
+  int box[4] = {0, 0, 0, 0};
+  bool empty = true;
+
+  _cursor_init(&cur, gfx, 0, 0, text);
+
+  while((glyph = _cursor_next(&cur, &xx, &yy)) != NULL)
+    _grow_bounds(&cur, gfx->mTextStyle, glyph, xx, yy, box, &empty);
+
+  rect->x = box[0];
+  rect->y = box[1];
+  rect->w = box[2] - box[0];
+  rect->h = box[3] - box[1];
+
+  return MRT_STATUS_OK;
+}
+
+mrt_status_t mono_gfx_prepare_text(mono_gfx_t* gfx, const char * text, GFXrun* run)
+{
+  //if a font has not been set, return error
+  if(gfx->mFont == NULL)
+    return MRT_STATUS_ERROR;
+
+  mono_gfx_cursor_t cur;
+  const GFXglyph* glyph;
+  int xx, yy;
+  int box[4] = {0, 0, 0, 0};
+  bool empty = true;
+
+  run->font = gfx->mFont;
+  run->count = 0;
+
+  _cursor_init(&cur, gfx, 0, 0, text);
+
+  while((glyph = _cursor_next(&cur, &xx, &yy)) != NULL)
+  {
+    if(run->count >= run->capacity)
+      return MRT_STATUS_ERROR;
+
+    run->items[run->count].glyph = glyph;
+    run->items[run->count].font = cur.glyphFont;
+    run->items[run->count].x = xx;
+    run->items[run->count].y = yy;
+    run->count++;
+
+    _grow_bounds(&cur, gfx->mTextStyle, glyph, xx, yy, box, &empty);
+  }
+
+  run->bounds.x = box[0];
+  run->bounds.y = box[1];
+  run->bounds.w = box[2] - box[0];
+  run->bounds.h = box[3] - box[1];
+
+  return MRT_STATUS_OK;
+}
+
+mrt_status_t mono_gfx_draw_run(mono_gfx_t* gfx, int x, int y, const GFXrun* run, uint8_t val)
+{
+  for(int i=0; i < run->count; i++)
+  {
+    _draw_glyph_at(gfx, run->items[i].font, run->items[i].glyph, x, y, run->items[i].x, run->items[i].y, val);
+  }
+
+  return MRT_STATUS_OK;
+}
+
+/**
+  *@brief gets the glyphs of a font for _numChars
+  *@param font ptr to font
+  *@param local storage for the glyphs, used if the font has no cache
+  *@return glyphs for _numChars, from the font's cache if it has one
+  */
+static const GFXglyph* const* _num_glyphs(const GFXfont* font, const GFXglyph** local)
+{
+  const GFXglyph** glyphs = (font->cache != NULL) ? font->cache->digits : local;
+
+  if((font->cache != NULL) && (font->cache->flags & MONO_GFX_FONT_CACHE_DIGITS))
+    return glyphs;
+
+  for(int i=0; i < MONO_GFX_NUM_SYM_SPACE; i++)
+    glyphs[i] = mono_gfx_get_glyph(font, _numChars[i]);
+
+  if(font->cache != NULL)
+    font->cache->flags |= MONO_GFX_FONT_CACHE_DIGITS;
+
+  return glyphs;
+}
+
+mrt_status_t mono_gfx_print_fixed(mono_gfx_t* gfx, int x, int y, int32_t value, int decimals, int width, uint8_t flags, uint8_t val)
+{
+  uint8_t syms[MONO_GFX_NUM_MAX_CHARS];     //_numChars indices, built from the right
+  GFXrunItem items[MONO_GFX_NUM_MAX_CHARS];
+  GFXrun run;
+  int n = MONO_GFX_NUM_MAX_CHARS;
+  uint32_t mag = (value < 0) ? -(uint32_t)value : (uint32_t)value;
+  uint8_t sign = 0;
+
+  if((gfx->mFont == NULL) || (decimals < 0) || (decimals > 10))
+    return MRT_STATUS_ERROR;
+
+  //look the glyphs up once per call instead of once per character, or once per font if it has a cache
+  const GFXglyph* numGlyphs[MONO_GFX_NUM_SYM_SPACE];
+  const GFXglyph* const* glyphs = _num_glyphs(gfx->mFont, numGlyphs);
+
+  //fraction digits, point, then at least one whole digit
+  for(int i=0; i < decimals; i++)
+  {
+    syms[--n] = mag % 10;
+    mag /= 10;
+  }
+  if(decimals > 0)
+    syms[--n] = MONO_GFX_NUM_SYM_POINT;
+  do
+  {
+    syms[--n] = mag % 10;
+    mag /= 10;
+  } while(mag > 0);
+
+  if(value < 0)
+    sign = MONO_GFX_NUM_SYM_MINUS;
+  else if(flags & MONO_GFX_NUM_SHOW_PLUS)
+    sign = MONO_GFX_NUM_SYM_PLUS;
+
+  if(width > MONO_GFX_NUM_MAX_CHARS)
+    width = MONO_GFX_NUM_MAX_CHARS;
+
+  //zeros go between the sign and the digits, spaces go in front of the sign
+  if(flags & MONO_GFX_NUM_ZERO_PAD)
+  {
+    while(MONO_GFX_NUM_MAX_CHARS - n < width - (sign ? 1 : 0))
+      syms[--n] = 0;
+  }
+  if(sign)
+    syms[--n] = sign;
+  while(MONO_GFX_NUM_MAX_CHARS - n < width)
+    syms[--n] = MONO_GFX_NUM_SYM_SPACE;
+
+  //lay the symbols out straight into a run
+  int scale = (gfx->mTextScale > 1) ? gfx->mTextScale : 1;
+  int bold = (gfx->mTextStyle & MONO_GFX_STYLE_BOLD) ? 1 : 0;
+  const GFXglyph* prev = NULL;
+  int pen = 0;
+
+  run.font = gfx->mFont;
+  run.items = items;
+  run.count = 0;
+
+  for(; n < MONO_GFX_NUM_MAX_CHARS; n++)
+  {
+    const GFXglyph* glyph = (syms[n] == MONO_GFX_NUM_SYM_SPACE) ? NULL : glyphs[syms[n]];
+
+    if(glyph == NULL)
+    {
+      //padding is as wide as a digit so columns of numbers line up
+      if((syms[n] == MONO_GFX_NUM_SYM_SPACE) && (glyphs[0] != NULL))
+        pen += (glyphs[0]->xAdvance + bold) * scale;
+      prev = NULL;
+      continue;
+    }
+
+    pen += mono_gfx_get_kerning(gfx->mFont, prev, glyph) * scale;
+    items[run.count].glyph = glyph;
+    items[run.count].font = gfx->mFont;
+    items[run.count].x = pen;
+    items[run.count].y = 0;
+    run.count++;
+    pen += (glyph->xAdvance + bold) * scale;
+    prev = glyph;
+  }
+
+  return mono_gfx_draw_run(gfx, x, y, &run, val);
+}
+
+mrt_status_t mono_gfx_print_int(mono_gfx_t* gfx, int x, int y, int32_t value, int width, uint8_t flags, uint8_t val)
+{
+  return mono_gfx_print_fixed(gfx, x, y, value, 0, width, flags, val);
+}
+
+mrt_status_t mono_gfx_measure(mono_gfx_t* gfx, const char * text, int* w, int* h)
+{
+  //if a font has not been set, return error
+  if(gfx->mFont == NULL)
+    return MRT_STATUS_ERROR;
+
+  mono_gfx_cursor_t cur;
+  int xx, yy;
+  int maxWidth = 0;
+
+  _cursor_init(&cur, gfx, 0, 0, text);
+
+  while(_cursor_next(&cur, &xx, &yy) != NULL)
+  {
+    if(cur.x > maxWidth)
+      maxWidth = cur.x;
+  }
+
+  *w = maxWidth;
+  *h = cur.y + (gfx->mFont->yAdvance * cur.scale);
+
+  //text running up or down the screen swaps the dimensions
+  if((gfx->mTextRotation == MONO_GFX_ROTATE_90) || (gfx->mTextRotation == MONO_GFX_ROTATE_270))
+  {
+    int tmp = *w;
+    *w = *h;
+    *h = tmp;
+  }
+
+  return MRT_STATUS_OK;
+}
+
+/**
+  *@brief clips a Bresenham line to the canvas before it is stepped. The line is described along its major axis, pixel i is at
+  *       a = a0 + sa*i, b = b0 + sb*k where k is the number of minor steps taken. With err starting at major/2, k for any i is
+  *       ceil((i*minor - major/2) / major), so the first and last visible steps can be worked out directly
+  *@param a0 major axis coord of the first pixel
+  *@param b0 minor axis coord of the first pixel
+  *@param sa direction of major steps (1 or -1)
+  *@param sb direction of minor steps (1 or -1)
+  *@param major length along the major axis
+  *@param minor length along the minor axis (<= major)
+  *@param aSize size of the canvas along the major axis
+  *@param bSize size of the canvas along the minor axis
+  *@param first ptr to store the first visible step
+  *@param last ptr to store the last visible step
+  *@param k ptr to store the minor steps taken before the first visible step
+  *@param err ptr to store the error term at the first visible step
+  *@return false if none of the line is on the canvas
+  */
+static bool _line_clip(int a0, int b0, int sa, int sb, int64_t major, int64_t minor, int aSize, int bSize, int64_t* first, int64_t* last, int64_t* k, int64_t* err)
+{
+  int64_t h = major / 2;
+  int64_t lo = 0;
+  int64_t hi = major;
+  int64_t kLo;
+  int64_t kHi;
+
+  //lines that are on the canvas from end to end need no work
+  if(((unsigned)a0 < (unsigned)aSize) && ((uint64_t)(a0 + (sa * major)) < (unsigned)aSize) &&
+     ((unsigned)b0 < (unsigned)bSize) && ((uint64_t)(b0 + (sb * minor)) < (unsigned)bSize))
+  {
+    *first = 0;
+    *last = major;
+    *k = 0;
+    *err = h;
+    return true;
+  }
+
+  //steps that keep the major coord on the canvas
+  if(sa > 0)
+  {
+    lo = (-(int64_t)a0 > lo) ? -(int64_t)a0 : lo;
+    hi = ((int64_t)aSize - 1 - a0 < hi) ? (int64_t)aSize - 1 - a0 : hi;
+  }
+  else
+  {
+    lo = ((int64_t)a0 - (aSize - 1) > lo) ? (int64_t)a0 - (aSize - 1) : lo;
+    hi = ((int64_t)a0 < hi) ? (int64_t)a0 : hi;
+  }
+
+  //minor steps that keep the minor coord on the canvas
+  if(sb > 0)
+  {
+    kLo = -(int64_t)b0;
+    kHi = (int64_t)bSize - 1 - b0;
+  }
+  else
+  {
+    kLo = (int64_t)b0 - (bSize - 1);
+    kHi = b0;
+  }
+
+  if((kHi < 0) || (kLo > minor))
+    return false;
+  if(kHi > minor)
+    kHi = minor;
+
+  //turn them into steps. major and minor can both be close to 2^32, so the products are taken unsigned, where they still fit
+  if(minor == 0)
+  {
+    if(kLo > 0)
+      return false;
+  }
+  else
+  {
+    if(kLo > 0)
+    {
+      int64_t i = (int64_t)(((((uint64_t)kLo - 1) * (uint64_t)major) + (uint64_t)h) / (uint64_t)minor) + 1;
+      lo = (i > lo) ? i : lo;
+    }
+    int64_t i = (int64_t)((((uint64_t)kHi * (uint64_t)major) + (uint64_t)h) / (uint64_t)minor);
+    hi = (i < hi) ? i : hi;
+  }
+
+  if(lo > hi)
+    return false;
+
+  uint64_t steps = 0;
+  uint64_t along = (uint64_t)lo * (uint64_t)minor;
+  if((major > 0) && (along > (uint64_t)h))
+    steps = (along - (uint64_t)h + (uint64_t)major - 1) / (uint64_t)major;
+
+  *first = lo;
+  *last = hi;
+  *k = (int64_t)steps;
+  *err = (int64_t)((uint64_t)h - along + (steps * (uint64_t)major));
+  return true;
+}
+
+//splits a step of n bits through the buffer into whole bytes and the bits left over (0 to 7)
+static void _bit_step(int n, int* bytes, int* bits)
+{
+  *bytes = (n >= 0) ? (n / 8) : -((7 - n) / 8);
+  *bits = n - (*bytes * 8);
+}
+
+/**
+  *@brief steps a clipped Bresenham line through a buffered canvas. The position is kept as a byte pointer and a bit offset that are
+  *       moved by the size of each step, so there is no multiply or divide per pixel
+  *@param gfx ptr to gfx canvas
+  *@param x x coord of the first pixel (must be on the canvas)
+  *@param y y coord of the first pixel
+  *@param majorStep bits moved through the buffer for each step (+-1 for x, +-mWidth for y)
+  *@param minorStep bits moved when the error term wraps
+  *@param major length along the major axis
+  *@param minor length along the minor axis
+  *@param err error term at the first pixel
+  *@param count number of pixels to step through
+  *@param pattern dash pattern, msb first (0xFFFFFFFF for a solid line)
+  *@param bit bit of the pattern for the first pixel
+  *@param last last bit of the pattern before it repeats
+  *@param val pixel value
+  */
+static inline void _line_bits(mono_gfx_t* gfx, int x, int y, int majorStep, int minorStep, int64_t major, int64_t minor, int64_t err, int count, uint32_t pattern, uint32_t bit, uint32_t last, uint8_t val)
+{
+  uint32_t pos = ((uint32_t)y * gfx->mWidth) + x;
+  uint8_t* p = &gfx->mBuffer[pos / 8];
+  int b = pos % 8;
+  int majorBytes, majorBits, minorBytes, minorBits;
+
+  _bit_step(majorStep, &majorBytes, &majorBits);
+  _bit_step(minorStep, &minorBytes, &minorBits);
+
+  for(;;)
+  {
+    if(pattern & bit)
+      _apply(p, 0x80 >> b, val);
+    bit = (bit == last) ? 0x80000000 : (bit >> 1);
+
+    if(--count == 0)
+      break;
+
+    p += majorBytes;
+    b += majorBits;
+    err -= minor;
+    if(err < 0)
+    {
+      p += minorBytes;
+      b += minorBits;
+      err += major;
+    }
+    p += b >> 3;
+    b &= 7;
+  }
+}
+
+/**
+  *@brief draws a clipped line that is mostly horizontal as one run of bits per row. The length of each run comes straight from the
+  *       error term, so the pixels in between are not stepped one at a time
+  *@param gfx ptr to gfx canvas
+  *@param x x coord of the first pixel (must be on the canvas)
+  *@param y y coord of the first pixel
+  *@param ystep direction the line moves between rows (1 or -1)
+  *@param major length along x
+  *@param minor length along y
+  *@param err error term at the first pixel
+  *@param count number of pixels to draw
+  *@param val pixel value
+  */
+static void _line_runs(mono_gfx_t* gfx, int x, int y, int ystep, int64_t major, int64_t minor, int64_t err, int count, uint8_t val)
+{
+  uint32_t pos = ((uint32_t)y * gfx->mWidth) + x;
+  uint32_t row = (ystep > 0) ? gfx->mWidth : -gfx->mWidth;
+
+  while(count > 0)
+  {
+    //pixels until the error term wraps
+    int64_t n = (minor > 0) ? (err / minor) + 1 : count;
+    if(n > count)
+      n = count;
+
+    _span_bits(gfx->mBuffer, pos, pos + (uint32_t)n - 1, 0xFF, val);
+    count -= (int)n;
+    err += major - (n * minor);
+    pos += (uint32_t)n + row;
+  }
+}
+
+/**
+  *@brief draws a line
+  *@param gfx ptr to gfx canvas
+  *@param x0 x coord of p1
+  *@param y0 y coord of p1
+  *@param x1 x coord of p2
+  *@param y1 y coord of p2
+  *@param open leave off the pixel at p2, so lines joined end to start do not draw any pixel twice
+  *@param val pixel value
+  */
+static void _line(mono_gfx_t* gfx, int x0, int y0, int x1, int y1, bool open, uint8_t val)
+{
+  //end points can be more than INT_MAX apart, so the differences are taken in 64 bits
+  bool steep = llabs((int64_t)y1 - y0) > llabs((int64_t)x1 - x0);
+  bool swapped = false;
+  if (steep) {
+      _swap_int(x0, y0);
+      _swap_int(x1, y1);
+  }
+
+  if (x0 > x1) {
+      _swap_int(x0, x1);
+      _swap_int(y0, y1);
+      swapped = true;
+  }
+
+  int64_t dx = (int64_t)x1 - x0;
+  int64_t dy = llabs((int64_t)y1 - y0);
+  int ystep = (y0 < y1) ? 1 : -1;
+  int64_t first, last, k, err;
+
+  //only the part of the line on the canvas is stepped
+  if(!_line_clip(x0, y0, 1, ystep, dx, dy, steep ? gfx->mHeight : gfx->mWidth, steep ? gfx->mWidth : gfx->mHeight, &first, &last, &k, &err))
+    return;
+
+  //p2 is the last pixel, or the first one if the ends were swapped
+  if(open)
+  {
+    if(!swapped)
+    {
+      if(last > dx - 1)
+        last = dx - 1;
+    }
+    else if(first == 0)
+    {
+      first = 1;
+      err -= dy;
+      if(err < 0)
+      {
+        k++;
+        err += dx;
+      }
+    }
+
+    if(first > last)
+      return;
+  }
+
+  //the clipped ends are on the canvas, so they fit in an int again
+  int y = (int)(y0 + (ystep * k));
+  int xFirst = (int)(x0 + first);
+  int xLast = (int)(x0 + last);
+
+  if(gfx->mBuffered)
+  {
+    //lines with runs of 3 or more pixels per row are cheaper to write a row at a time. dy <= dx / 3 is dy * 3 <= dx without the overflow
+    if(steep)
+      _line_bits(gfx, y, xFirst, gfx->mWidth, ystep, dx, dy, err, xLast - xFirst + 1, 0xFFFFFFFF, 0x80000000, 0x00000001, val);
+    else if(dy <= dx / 3)
+      _line_runs(gfx, xFirst, y, ystep, dx, dy, err, xLast - xFirst + 1, val);
+    else
+      _line_bits(gfx, xFirst, y, 1, ystep * gfx->mWidth, dx, dy, err, xLast - xFirst + 1, 0xFFFFFFFF, 0x80000000, 0x00000001, val);
+    return;
+  }
+
+  for (int x = xFirst; x <= xLast; x++) {
+      if (steep) {
+          gfx->fWritePixel(gfx, y, x, val);
+      } else {
+          gfx->fWritePixel(gfx, x, y, val);
+      }
+      err -= dy;
+      if (err < 0) {
+          y += ystep;
+          err += dx;
+      }
+  }
+}
+
+mrt_status_t mono_gfx_draw_line(mono_gfx_t* gfx, int x0, int y0, int x1, int y1, uint8_t val)
+{
+  _line(gfx, x0, y0, x1, y1, false, val);
+
+  return MRT_STATUS_OK;
+}
+
+/**
+  *@brief fills columns x0 to x1 on rows y0 to y1. Rows are walked by adding the stride, and bands that sit inside one byte on every row
+  *       are a single masked write per row
+  *@param gfx ptr to gfx canvas
+  *@param x0 first x coord
+  *@param x1 last x coord (inclusive)
+  *@param y0 first y coord
+  *@param y1 last y coord (inclusive)
+  *@param pattern 8x8 brush, or NULL for solid
+  *@param val pixel value
+  */
+static void _fill_rect(mono_gfx_t* gfx, int x0, int x1, int y0, int y1, const uint8_t* pattern, uint8_t val)
+{
+  if(x0 < 0)
+    x0 = 0;
+  if(x1 >= gfx->mWidth)
+    x1 = gfx->mWidth - 1;
+  if(y0 < 0)
+    y0 = 0;
+  if(y1 >= gfx->mHeight)
+    y1 = gfx->mHeight - 1;
+  if((x0 > x1) || (y0 > y1))
+    return;
+
+  if(!gfx->mBuffered)
+  {
+    for(int y = y0; y <= y1; y++)
+      _span_pattern(gfx, x0, x1, y, _brush_row(pattern, y), val);
+    return;
+  }
+
+  uint32_t first = (y0 * gfx->mWidth) + x0;
+  uint32_t last = first + (x1 - x0);
+
+  //rows start on a byte, so brush rows are already lined up with the buffer
+  if(((gfx->mWidth % 8) == 0) && ((first / 8) == (last / 8)))
+  {
+    uint8_t* p = &gfx->mBuffer[first / 8];
+    uint8_t mask = (0xFF >> (first % 8)) & (0xFF << (7 - (last % 8)));
+    int stride = gfx->mWidth / 8;
+
+    for(int y = y0; y <= y1; y++)
+    {
+      _apply(p, mask & _brush_row(pattern, y), val);
+      p += stride;
+    }
+    return;
+  }
+
+  for(int y = y0; y <= y1; y++)
+  {
+    _span_bits(gfx->mBuffer, first, last, _pattern_align(_brush_row(pattern, y), first - x0), val);
+    first += gfx->mWidth;
+    last += gfx->mWidth;
+  }
+}
+
+mrt_status_t mono_gfx_draw_rect(mono_gfx_t* gfx, int x, int y, int w, int h,  uint8_t val)
+{
+  if((w > 0) && (h > 0))
+    _fill_rect(gfx, x, x + w - 1, y, y + h - 1, gfx->mPattern, val);
+
+  return MRT_STATUS_OK;
+}
+
+mrt_status_t mono_gfx_draw_rect_outline(mono_gfx_t* gfx, int x, int y, int w, int h, int stroke, uint8_t val)
+{
+  if((w <= 0) || (h <= 0) || (stroke <= 0))
+    return MRT_STATUS_OK;
+
+  //sides that meet in the middle leave no hole
+  if((stroke * 2 >= w) || (stroke * 2 >= h))
+  {
+    _fill_rect(gfx, x, x + w - 1, y, y + h - 1, NULL, val);
+    return MRT_STATUS_OK;
+  }
+
+  //top and bottom run the full width, so the sides only cover the rows between them and no corner is drawn twice
+  _fill_rect(gfx, x, x + w - 1, y, y + stroke - 1, NULL, val);
+  _fill_rect(gfx, x, x + w - 1, y + h - stroke, y + h - 1, NULL, val);
+  _fill_rect(gfx, x, x + stroke - 1, y + stroke, y + h - stroke - 1, NULL, val);
+  _fill_rect(gfx, x + w - stroke, x + w - 1, y + stroke, y + h - stroke - 1, NULL, val);
+
+  return MRT_STATUS_OK;
+}
+
+//integer square root, rounded down
+static uint32_t _isqrt(uint64_t n)
+{
+  uint64_t root = 0;
+  uint64_t bit = (uint64_t)1 << 62;
+
+  while(bit > n)
+    bit >>= 2;
+
+  while(bit != 0)
+  {
+    if(n >= root + bit)
+    {
+      n -= root + bit;
+      root = (root >> 1) + bit;
+    }
+    else
+    {
+      root >>= 1;
+    }
+    bit >>= 2;
+  }
+
+  return (uint32_t)root;
+}
+
+/**
+  *@brief state for walking the rows of an ellipse quadrant with the midpoint test.
+  *       Pixel (x,y) is inside if it is inside the ellipse with radii rx+1/2 and ry+1/2, which for a circle is x*x + y*y <= r*r + r
+  */
+typedef struct{
+  int64_t a4;             //4 * (2ry+1)^2, weight of x*x
+  int64_t b4;             //4 * (2rx+1)^2, weight of y*y
+  int64_t limit;          //(2rx+1)^2 * (2ry+1)^2
+  int64_t tx;             //a4 * x*x
+  int64_t ty;             //b4 * y*y
+  int x;                  //half width of the current row
+  int y;                  //row, counted out from the center
+}mono_gfx_arc_t;
+
+/**
+  *@brief starts the walk at a row of the quadrant, with the widest x that is inside on that row
+  *@param arc ptr to arc state
+  *@param rx horizontal radius (at most MONO_GFX_ROUND_LIMIT, so the decision terms fit in 64 bits)
+  *@param ry vertical radius (at most MONO_GFX_ROUND_LIMIT)
+  *@param y row to start on, counted out from the center (0 to ry)
+  */
+static void _arc_init(mono_gfx_arc_t* arc, int rx, int ry, int y)
+{
+  int64_t w = (2 * (int64_t)rx) + 1;
+  int64_t h = (2 * (int64_t)ry) + 1;
+
+  arc->a4 = 4 * h * h;
+  arc->b4 = 4 * w * w;
+  arc->limit = w * w * h * h;
+  arc->y = y;
+  arc->ty = arc->b4 * y * y;
+  arc->x = (int)_isqrt((uint64_t)(arc->limit - arc->ty) / (uint64_t)arc->a4);
+  arc->tx = arc->a4 * arc->x * arc->x;
+}
+
+//moves to the next row out from the center and returns its half width
+static int _arc_next(mono_gfx_arc_t* arc)
+{
+  arc->ty += arc->b4 * ((2 * (int64_t)arc->y) + 1);
+  arc->y++;
+
+  //step in until the pixel is inside again, the decision terms are updated by differences so there are no multiplies of x
+  while((arc->x >= 0) && (arc->tx + arc->ty > arc->limit))
+  {
+    arc->tx -= arc->a4 * ((2 * (int64_t)arc->x) - 1);
+    arc->x--;
+  }
+
+  return arc->x;
+}
+
+//pulls a span end that is off the side of the canvas in to just past it, so the span can be passed on as an int
+static inline int _span_x(const mono_gfx_t* gfx, int64_t x)
+{
+  if(x < -1)
+    return -1;
+  return (x > gfx->mWidth) ? gfx->mWidth : (int)x;
+}
+
+/**
+  *@brief draws a rect with elliptical corners, one row at a time as spans. Circles and ellipses are the case where the inner rect is a single point.
+  *       Only the rows on the canvas are walked
+  *@param gfx ptr to gfx canvas
+  *@param x0 left edge of the inner rect (center of the left corners)
+  *@param x1 right edge of the inner rect
+  *@param y0 top edge of the inner rect (center of the top corners)
+  *@param y1 bottom edge of the inner rect
+  *@param rx horizontal radius of the corners (0 to MONO_GFX_ROUND_LIMIT)
+  *@param ry vertical radius of the corners (0 to MONO_GFX_ROUND_LIMIT)
+  *@param fill true to fill, false for a one pixel outline
+  *@param val pixel value
+  */
+static void _round_shape(mono_gfx_t* gfx, int64_t x0, int64_t x1, int64_t y0, int64_t y1, int rx, int ry, bool fill, uint8_t val)
+{
+  const uint8_t* pattern = fill ? gfx->mPattern : NULL;
+  mono_gfx_arc_t arc;
+  int half;
+  int next;
+
+  if((x1 + rx < 0) || (x0 - rx >= gfx->mWidth) || (y1 + ry < 0) || (y0 - ry >= gfx->mHeight))
+    return;
+
+  //straight sides between the corners
+  int64_t top = (y0 + 1 > 0) ? y0 + 1 : 0;
+  int64_t bottom = (y1 < gfx->mHeight) ? y1 : gfx->mHeight;
+  for(int y = (int)top; y < bottom; y++)
+  {
+    if(fill || (x1 - x0 + (2 * rx) < 2))
+    {
+      _span_pattern(gfx, _span_x(gfx, x0 - rx), _span_x(gfx, x1 + rx), y, _brush_row(pattern, y), val);
+    }
+    else
+    {
+      _span(gfx, _span_x(gfx, x0 - rx), _span_x(gfx, x0 - rx), y, val);
+      _span(gfx, _span_x(gfx, x1 + rx), _span_x(gfx, x1 + rx), y, val);
+    }
+  }
+
+  //corner rows that are on the canvas, above the inner rect (y0 - dy) and below it (y1 + dy)
+  int64_t first = ry + 1;
+  int64_t last = -1;
+  int64_t lo = (y0 - gfx->mHeight + 1 > 0) ? y0 - gfx->mHeight + 1 : 0;
+  int64_t hi = (y0 < ry) ? y0 : ry;
+  if(lo <= hi)
+  {
+    first = lo;
+    last = hi;
+  }
+  lo = (-y1 > 0) ? -y1 : 0;
+  hi = (gfx->mHeight - 1 - y1 < ry) ? gfx->mHeight - 1 - y1 : ry;
+  if(lo <= hi)
+  {
+    first = (lo < first) ? lo : first;
+    last = (hi > last) ? hi : last;
+  }
+
+  if(first > last)
+    return;
+
+  //corner rows, each row is drawn once so inverted shapes come out clean
+  _arc_init(&arc, rx, ry, (int)first);
+  half = arc.x;
+
+  for(int dy = (int)first; dy <= last; dy++)
+  {
+    next = (dy < ry) ? _arc_next(&arc) : -1;
+
+    for(int side = 0; side < 2; side++)
+    {
+      int64_t y = (side == 0) ? y0 - dy : y1 + dy;
+
+      if((side == 1) && (dy == 0) && (y0 == y1))
+        break;
+      if((y < 0) || (y >= gfx->mHeight))
+        continue;
+
+      //outline covers from this row's edge in to just past the next row's edge
+      int inner = (next + 1 < half) ? next + 1 : half;
+
+      if(fill || (next < 0) || (x0 - inner >= x1 + inner - 1))
+      {
+        _span_pattern(gfx, _span_x(gfx, x0 - half), _span_x(gfx, x1 + half), (int)y, _brush_row(pattern, (int)y), val);
+      }
+      else
+      {
+        _span(gfx, _span_x(gfx, x0 - half), _span_x(gfx, x0 - inner), (int)y, val);
+        _span(gfx, _span_x(gfx, x1 + inner), _span_x(gfx, x1 + half), (int)y, val);
+      }
+    }
+
+    half = next;
+  }
+}
+
+mrt_status_t mono_gfx_draw_circle(mono_gfx_t* gfx, int x, int y, int r, uint8_t val)
+{
+  if(r > MONO_GFX_ROUND_LIMIT)
+    return MRT_STATUS_ERROR;
+
+  if(r >= 0)
+    _round_shape(gfx, x, x, y, y, r, r, false, val);
+
+  return MRT_STATUS_OK;
+}
+
+mrt_status_t mono_gfx_fill_circle(mono_gfx_t* gfx, int x, int y, int r, uint8_t val)
+{
+  if(r > MONO_GFX_ROUND_LIMIT)
+    return MRT_STATUS_ERROR;
+
+  if(r >= 0)
+    _round_shape(gfx, x, x, y, y, r, r, true, val);
+
+  return MRT_STATUS_OK;
+}
+
+mrt_status_t mono_gfx_draw_ellipse(mono_gfx_t* gfx, int x, int y, int rx, int ry, uint8_t val)
+{
+  if((rx > MONO_GFX_ROUND_LIMIT) || (ry > MONO_GFX_ROUND_LIMIT))
+    return MRT_STATUS_ERROR;
+
+  if((rx >= 0) && (ry >= 0))
+    _round_shape(gfx, x, x, y, y, rx, ry, false, val);
+
+  return MRT_STATUS_OK;
+}
+
+mrt_status_t mono_gfx_fill_ellipse(mono_gfx_t* gfx, int x, int y, int rx, int ry, uint8_t val)
+{
+  if((rx > MONO_GFX_ROUND_LIMIT) || (ry > MONO_GFX_ROUND_LIMIT))
+    return MRT_STATUS_ERROR;
+
+  if((rx >= 0) && (ry >= 0))
+    _round_shape(gfx, x, x, y, y, rx, ry, true, val);
+
+  return MRT_STATUS_OK;
+}
+
+//fits the corner radius of a rounded rect so the inner rect is at least one pixel
+static int _round_rect_radius(int w, int h, int r)
+{
+  int max = (((w < h) ? w : h) - 1) / 2;
+
+  if(r > max)
+    r = max;
+  return (r < 0) ? 0 : r;
+}
+
+mrt_status_t mono_gfx_draw_round_rect(mono_gfx_t* gfx, int x, int y, int w, int h, int r, uint8_t val)
+{
+  if((w <= 0) || (h <= 0))
+    return MRT_STATUS_OK;
+
+  r = _round_rect_radius(w, h, r);
+  if(r > MONO_GFX_ROUND_LIMIT)
+    return MRT_STATUS_ERROR;
+
+  _round_shape(gfx, (int64_t)x + r, (int64_t)x + w - 1 - r, (int64_t)y + r, (int64_t)y + h - 1 - r, r, r, false, val);
+
+  return MRT_STATUS_OK;
+}
+
+mrt_status_t mono_gfx_fill_round_rect(mono_gfx_t* gfx, int x, int y, int w, int h, int r, uint8_t val)
+{
+  if((w <= 0) || (h <= 0))
+    return MRT_STATUS_OK;
+
+  r = _round_rect_radius(w, h, r);
+  if(r > MONO_GFX_ROUND_LIMIT)
+    return MRT_STATUS_ERROR;
+
+  _round_shape(gfx, (int64_t)x + r, (int64_t)x + w - 1 - r, (int64_t)y + r, (int64_t)y + h - 1 - r, r, r, true, val);
+
+  return MRT_STATUS_OK;
+}
+
+/**
+  *@brief polygon edge stepped one row at a time with integer math. Coords are in units of 1/(1 << shift) pixels, and the exact crossing on the current row is x + r/dy.
+  *       Corners can be any int, so the crossing and the steps are kept in 64 bits
+  */
+typedef struct{
+  int y0;                 //first row the edge covers
+  int y1;                 //row after the last one it covers
+  int64_t x;              //whole part of the crossing
+  int64_t r;              //remainder of the crossing, 0 <= r < dy
+  int64_t q;              //whole pixels moved per row
+  int64_t rem;            //remainder moved per row
+  int64_t dy;             //rows from end to end
+  int dir;                //+1 if the edge runs down the screen, -1 if it runs up
+  int shift;              //sub pixel bits in x and dy
+}mono_gfx_edge_t;
+
+/**
+  *@brief sets up an edge for the pixel rows between top and bottom
+  *@return false if the edge is horizontal or does not cover any of the rows
+  */
+static bool _edge_init(mono_gfx_edge_t* edge, int xa, int ya, int xb, int yb, int shift, int top, int bottom)
+{
+  edge->dir = 1;
+  if(ya > yb)
+  {
+    int t = xa; xa = xb; xb = t;
+    t = ya; ya = yb; yb = t;
+    edge->dir = -1;
+  }
+
+  //rows ya <= y < yb belong to the edge, so edges that meet at a corner do not both count it
+  int64_t first = ((int64_t)ya + (1 << shift) - 1) >> shift;
+  int64_t last = ((int64_t)yb + (1 << shift) - 1) >> shift;
+  edge->y0 = (first > top) ? (int)first : top;
+  edge->y1 = (last < bottom) ? (int)last : bottom;
+  if(edge->y0 >= edge->y1)
+    return false;
+
+  int64_t dx = (int64_t)xb - xa;
+  int64_t step = dx * (1 << shift);
+  edge->shift = shift;
+  edge->dy = (int64_t)yb - ya;
+  edge->q = step / edge->dy;
+  edge->rem = step % edge->dy;
+  if(edge->rem < 0)
+  {
+    edge->q--;
+    edge->rem += edge->dy;
+  }
+
+  //jump to the first visible row. (down * dx) / dy can need 64 bits for each factor, so dx is split into whole steps of dy and what
+  //is left over, which keeps the product that is divided below 2^64
+  int64_t down = ((int64_t)edge->y0 * (1 << shift)) - ya;
+  int64_t dq = dx / edge->dy;
+  int64_t dr = dx % edge->dy;
+  if(dr < 0)
+  {
+    dq--;
+    dr += edge->dy;
+  }
+  uint64_t num = (uint64_t)down * (uint64_t)dr;
+  edge->x = xa + (down * dq) + (int64_t)(num / (uint64_t)edge->dy);
+  edge->r = (int64_t)(num % (uint64_t)edge->dy);
+
+  return true;
+}
+
+static inline void _edge_step(mono_gfx_edge_t* edge)
+{
+  edge->x += edge->q;
+  edge->r += edge->rem;
+  if(edge->r >= edge->dy)
+  {
+    edge->r -= edge->dy;
+    edge->x++;
+  }
+}
+
+//first pixel at or right of the crossing. Crossings far off the canvas are pulled in to +-INT_MAX/2, which keeps their order and leaves room for the +-1 of a span end
+static inline int _edge_ceil(const mono_gfx_edge_t* edge)
+{
+  int64_t c = (edge->x + (1 << edge->shift) - 1 + ((edge->r > 0) ? 1 : 0)) >> edge->shift;
+  if(c > INT_MAX / 2)
+    return INT_MAX / 2;
+  return (c < -(INT_MAX / 2)) ? -(INT_MAX / 2) : (int)c;
+}
+
+//fills a triangle with corners in units of 1/(1 << shift) pixels, with an 8x8 brush (NULL for solid)
+static void _fill_triangle(mono_gfx_t* gfx, int x0, int y0, int x1, int y1, int x2, int y2, int shift, const uint8_t* pattern, uint8_t val)
+{
+  mono_gfx_edge_t full;
+  mono_gfx_edge_t upper;
+  mono_gfx_edge_t lower;
+  int t;
+
+  //sort the corners top to bottom
+  if(y0 > y1) { t = x0; x0 = x1; x1 = t; t = y0; y0 = y1; y1 = t; }
+  if(y1 > y2) { t = x1; x1 = x2; x2 = t; t = y1; y1 = y2; y2 = t; }
+  if(y0 > y1) { t = x0; x0 = x1; x1 = t; t = y0; y0 = y1; y1 = t; }
+
+  //one edge runs the full height, the other side is two edges that meet at the middle corner
+  if(!_edge_init(&full, x0, y0, x2, y2, shift, 0, gfx->mHeight))
+    return;
+
+  _edge_init(&upper, x0, y0, x1, y1, shift, 0, gfx->mHeight);
+  _edge_init(&lower, x1, y1, x2, y2, shift, 0, gfx->mHeight);
+  int64_t middle = ((int64_t)y1 + (1 << shift) - 1) >> shift;
+
+  for(int y = full.y0; y < full.y1; y++)
+  {
+    mono_gfx_edge_t* side = (y < middle) ? &upper : &lower;
+    int a = _edge_ceil(&full);
+    int b = _edge_ceil(side);
+
+    if(a < b)
+      _span_pattern(gfx, a, b - 1, y, _brush_row(pattern, y), val);
+    else
+      _span_pattern(gfx, b, a - 1, y, _brush_row(pattern, y), val);
+
+    _edge_step(&full);
+    _edge_step(side);
+  }
+}
+
+mrt_status_t mono_gfx_fill_triangle(mono_gfx_t* gfx, int x0, int y0, int x1, int y1, int x2, int y2, uint8_t val)
+{
+  _fill_triangle(gfx, x0, y0, x1, y1, x2, y2, 0, gfx->mPattern, val);
+
+  return MRT_STATUS_OK;
+}
+
+//fills a polygon with corners in units of 1/(1 << shift) pixels, with an 8x8 brush (NULL for solid)
+static mrt_status_t _fill_polygon(mono_gfx_t* gfx, const GFXpoint* points, int count, int shift, uint8_t rule, const uint8_t* pattern, uint8_t val)
+{
+  mono_gfx_edge_t edges[MONO_GFX_POLY_MAX_EDGES];
+  mono_gfx_edge_t* active[MONO_GFX_POLY_MAX_EDGES];
+  int edgeCount = 0;
+  int activeCount = 0;
+  int next = 0;
+  int bottom = 0;
+
+  if(count > MONO_GFX_POLY_MAX_EDGES)
+    return MRT_STATUS_ERROR;
+
+  if(count < 3)
+    return MRT_STATUS_OK;
+
+  if(count == 3)
+  {
+    _fill_triangle(gfx, points[0].x, points[0].y, points[1].x, points[1].y, points[2].x, points[2].y, shift, pattern, val);
+    return MRT_STATUS_OK;
+  }
+
+  //edge table, sorted by first row
+  for(int i=0; i < count; i++)
+  {
+    const GFXpoint* a = &points[i];
+    const GFXpoint* b = &points[(i + 1 < count) ? i + 1 : 0];
+    mono_gfx_edge_t edge;
+
+    if(!_edge_init(&edge, a->x, a->y, b->x, b->y, shift, 0, gfx->mHeight))
+      continue;
+
+    int k = edgeCount++;
+    while((k > 0) && (edges[k - 1].y0 > edge.y0))
+    {
+      edges[k] = edges[k - 1];
+      k--;
+    }
+    edges[k] = edge;
+
+    if(edge.y1 > bottom)
+      bottom = edge.y1;
+  }
+
+  if(edgeCount == 0)
+    return MRT_STATUS_OK;
+
+  for(int y = edges[0].y0; y < bottom; y++)
+  {
+    //add edges that start on this row and drop the ones that have ended
+    while((next < edgeCount) && (edges[next].y0 <= y))
+      active[activeCount++] = &edges[next++];
+
+    int kept = 0;
+    for(int i=0; i < activeCount; i++)
+    {
+      if(active[i]->y1 > y)
+        active[kept++] = active[i];
+    }
+    activeCount = kept;
+
+    //gap between parts of the polygon
+    if(activeCount == 0)
+    {
+      y = edges[next].y0 - 1;
+      continue;
+    }
+
+    //crossings only swap where edges cross, so the list stays nearly sorted and insertion sort is cheap
+    for(int i=1; i < activeCount; i++)
+    {
+      mono_gfx_edge_t* edge = active[i];
+      int key = _edge_ceil(edge);
+      int k = i;
+      while((k > 0) && (_edge_ceil(active[k - 1]) > key))
+      {
+        active[k] = active[k - 1];
+        k--;
+      }
+      active[k] = edge;
+    }
+
+    if(rule == MONO_GFX_FILL_NON_ZERO)
+    {
+      int winding = 0;
+      int start = 0;
+      for(int i=0; i < activeCount; i++)
+      {
+        if(winding == 0)
+          start = _edge_ceil(active[i]);
+
+        winding += active[i]->dir;
+
+        if(winding == 0)
+          _span_pattern(gfx, start, _edge_ceil(active[i]) - 1, y, _brush_row(pattern, y), val);
+      }
+    }
+    else
+    {
+      for(int i=0; i + 1 < activeCount; i += 2)
+        _span_pattern(gfx, _edge_ceil(active[i]), _edge_ceil(active[i + 1]) - 1, y, _brush_row(pattern, y), val);
+    }
+
+    for(int i=0; i < activeCount; i++)
+      _edge_step(active[i]);
+  }
+
+  return MRT_STATUS_OK;
+}
+
+mrt_status_t mono_gfx_fill_polygon(mono_gfx_t* gfx, const GFXpoint* points, int count, uint8_t rule, uint8_t val)
+{
+  return _fill_polygon(gfx, points, count, 0, rule, gfx->mPattern, val);
+}
+
+//cos and sin from 0 to 180 degrees, scaled by 1 << 14. Round caps are a half circle of MONO_GFX_CAP_STEPS segments
+#define MONO_GFX_CAP_STEPS 8
+static const int16_t _capCos[MONO_GFX_CAP_STEPS + 1] = {16384, 15137, 11585, 6270, 0, -6270, -11585, -15137, -16384};
+static const int16_t _capSin[MONO_GFX_CAP_STEPS + 1] = {0, 6270, 11585, 15137, 16384, 15137, 11585, 6270, 0};
+
+#define MONO_GFX_THICK_LIMIT (1 << 22)   //end points further off than this many pixels are clipped before the stroke is set up
+#define MONO_GFX_CLIP_FRAC 24             //fraction bits below 1/16 pixel used while clipping
+
+/**
+  *@brief clips a segment to one side of a vertical or horizontal line. The crossing is found by halving the segment,
+  *       so nothing is multiplied and end points anywhere in the int range stay exact
+  *@param a first end point, coords in any fixed point unit
+  *@param b second end point
+  *@param axis 0 to clip against x = bound, 1 for y = bound
+  *@param bound coord of the line
+  *@param sign 1 to keep the part at or above bound, -1 for at or below
+  *@return false if none of the segment is on that side
+  */
+static bool _clip_side(int64_t* a, int64_t* b, int axis, int64_t bound, int sign)
+{
+  bool aIn = ((a[axis] - bound) * sign >= 0);
+  bool bIn = ((b[axis] - bound) * sign >= 0);
+
+  if(aIn && bIn)
+    return true;
+  if(!aIn && !bIn)
+    return false;
+
+  //lo stays on the kept side and hi on the other until they are next to each other
+  int64_t* out = aIn ? b : a;
+  int64_t lo[2] = { aIn ? a[0] : b[0], aIn ? a[1] : b[1] };
+  int64_t hi[2] = { out[0], out[1] };
+
+  while((llabs(hi[0] - lo[0]) > 1) || (llabs(hi[1] - lo[1]) > 1))
+  {
+    int64_t mid[2] = { lo[0] + ((hi[0] - lo[0]) / 2), lo[1] + ((hi[1] - lo[1]) / 2) };
+    if((mid[axis] - bound) * sign >= 0)
+    {
+      lo[0] = mid[0];
+      lo[1] = mid[1];
+    }
+    else
+    {
+      hi[0] = mid[0];
+      hi[1] = mid[1];
+    }
+  }
+
+  out[0] = lo[0];
+  out[1] = lo[1];
+  return true;
+}
+
+mrt_status_t mono_gfx_draw_line_thick(mono_gfx_t* gfx, int x0, int y0, int x1, int y1, int width, uint8_t cap, uint8_t val)
+{
+  GFXpoint outline[2 * (MONO_GFX_CAP_STEPS + 1)];
+  int count = 0;
+
+  if(width <= 1)
+    return mono_gfx_draw_line(gfx, x0, y0, x1, y1, val);
+
+  if(width > UINT16_MAX)
+    return MRT_STATUS_ERROR;
+
+  //direction of the line, scaled down if needed so its length can be squared. It only has to be good to 1/2^14
+  int64_t dx = (int64_t)x1 - x0;
+  int64_t dy = (int64_t)y1 - y0;
+  while((llabs(dx) >= (1 << 22)) || (llabs(dy) >= (1 << 22)))
+  {
+    dx /= 2;
+    dy /= 2;
+  }
+
+  //the stroke is filled as one polygon in 1/16 pixels, so the sides land between pixels and nothing is drawn twice
+  uint32_t len = _isqrt((uint64_t)((dx * dx) + (dy * dy)) << 16);
+  int64_t ux = 1 << 14;
+  int64_t uy = 0;
+  if(len > 0)
+  {
+    ux = (dx * (1 << 22)) / len;
+    uy = (dy * (1 << 22)) / len;
+  }
+
+  //half width along the line and across it
+  int half = width * 8;
+  int ax = (int)((ux * half) >> 14);
+  int ay = (int)((uy * half) >> 14);
+  int nx = -ay;
+  int ny = ax;
+
+  //end points far off the canvas are moved along the line to a margin around it that the stroke and its caps can not reach across
+  if( (llabs(x0) > MONO_GFX_THICK_LIMIT) || (llabs(y0) > MONO_GFX_THICK_LIMIT) ||
+      (llabs(x1) > MONO_GFX_THICK_LIMIT) || (llabs(y1) > MONO_GFX_THICK_LIMIT) )
+  {
+    int64_t one = (int64_t)16 << MONO_GFX_CLIP_FRAC;
+    int64_t margin = (int64_t)(width + 2) * one;
+    int64_t a[2] = { x0 * one, y0 * one };
+    int64_t b[2] = { x1 * one, y1 * one };
+
+    if( !_clip_side(a, b, 0, -margin, 1) || !_clip_side(a, b, 0, (gfx->mWidth * one) + margin, -1) ||
+        !_clip_side(a, b, 1, -margin, 1) || !_clip_side(a, b, 1, (gfx->mHeight * one) + margin, -1) )
+      return MRT_STATUS_OK;
+
+    //back to 1/16 pixels, rounded to nearest
+    int64_t round = (int64_t)1 << (MONO_GFX_CLIP_FRAC - 1);
+    x0 = (int)((a[0] + round) >> MONO_GFX_CLIP_FRAC);
+    y0 = (int)((a[1] + round) >> MONO_GFX_CLIP_FRAC);
+    x1 = (int)((b[0] + round) >> MONO_GFX_CLIP_FRAC);
+    y1 = (int)((b[1] + round) >> MONO_GFX_CLIP_FRAC);
+  }
+  else
+  {
+    x0 *= 16;
+    y0 *= 16;
+    x1 *= 16;
+    y1 *= 16;
+  }
+
+  if(cap == MONO_GFX_CAP_ROUND)
+  {
+    //around the far end from one side to the other, then back around the near end
+    for(int i=0; i <= MONO_GFX_CAP_STEPS; i++)
+    {
+      outline[count].x = x1 + (int)((((int64_t)_capCos[i] * nx) + ((int64_t)_capSin[i] * ax)) >> 14);
+      outline[count++].y = y1 + (int)((((int64_t)_capCos[i] * ny) + ((int64_t)_capSin[i] * ay)) >> 14);
+    }
+    for(int i=0; i <= MONO_GFX_CAP_STEPS; i++)
+    {
+      outline[count].x = x0 - (int)((((int64_t)_capCos[i] * nx) + ((int64_t)_capSin[i] * ax)) >> 14);
+      outline[count++].y = y0 - (int)((((int64_t)_capCos[i] * ny) + ((int64_t)_capSin[i] * ay)) >> 14);
+    }
+  }
+  else
+  {
+    if(cap != MONO_GFX_CAP_SQUARE)
+    {
+      ax = 0;
+      ay = 0;
+    }
+
+    outline[0].x = x1 + ax + nx;
+    outline[0].y = y1 + ay + ny;
+    outline[1].x = x1 + ax - nx;
+    outline[1].y = y1 + ay - ny;
+    outline[2].x = x0 - ax - nx;
+    outline[2].y = y0 - ay - ny;
+    outline[3].x = x0 - ax + nx;
+    outline[3].y = y0 - ay + ny;
+    count = 4;
+  }
+
+  return _fill_polygon(gfx, outline, count, 4, MONO_GFX_FILL_NON_ZERO, NULL, val);
+}
+
+mrt_status_t mono_gfx_draw_line_dashed(mono_gfx_t* gfx, int x0, int y0, int x1, int y1, uint32_t pattern, int length, uint8_t val)
+{
+  if((length < 1) || (length > 32))
+    return MRT_STATUS_ERROR;
+
+  int64_t dx = llabs((int64_t)x1 - x0);
+  int64_t dy = llabs((int64_t)y1 - y0);
+  int sx = (x0 < x1) ? 1 : -1;
+  int sy = (y0 < y1) ? 1 : -1;
+  bool steep = dy > dx;
+  int64_t major = steep ? dy : dx;
+  int64_t minor = steep ? dx : dy;
+  int majorX = steep ? 0 : sx;
+  int majorY = steep ? sy : 0;
+  int64_t err;
+  uint32_t last = 0x80000000 >> (length - 1);
+  bool runs = !gfx->mBuffered && (gfx->fWriteSpan != NULL);
+  bool inRun = false;
+  int runStart = 0;
+  int runEnd = 0;
+  int runY = 0;
+  int64_t first, end, k;
+
+  if(!_line_clip(steep ? y0 : x0, steep ? x0 : y0, steep ? sy : sx, steep ? sx : sy, major, minor,
+                 steep ? gfx->mHeight : gfx->mWidth, steep ? gfx->mWidth : gfx->mHeight, &first, &end, &k, &err))
+    return MRT_STATUS_OK;
+
+  //start at the first visible pixel, with the pattern where it would be if the line had been stepped from p1
+  uint32_t bit = 0x80000000 >> (first % length);
+  int x = (int)(steep ? x0 + (sx * k) : x0 + (sx * first));
+  int y = (int)(steep ? y0 + (sy * first) : y0 + (sy * k));
+  int count = (int)(end - first + 1);
+
+  if(gfx->mBuffered)
+  {
+    if(steep)
+      _line_bits(gfx, x, y, sy * gfx->mWidth, sx, major, minor, err, count, pattern, bit, last, val);
+    else
+      _line_bits(gfx, x, y, sx, sy * gfx->mWidth, major, minor, err, count, pattern, bit, last, val);
+    return MRT_STATUS_OK;
+  }
+
+  //the pattern is walked one bit per pixel. With a span callback, pixels that are on and share a row are sent as one span
+  for(int i = 0; i < count; i++)
+  {
+    if(pattern & bit)
+    {
+      if(!runs)
+      {
+        _plot(gfx, x, y, val);
+      }
+      else
+      {
+        if(inRun && (y != runY))
+        {
+          _span(gfx, (runStart < runEnd) ? runStart : runEnd, (runStart < runEnd) ? runEnd : runStart, runY, val);
+          inRun = false;
+        }
+        if(!inRun)
+        {
+          runStart = x;
+          runY = y;
+          inRun = true;
+        }
+        runEnd = x;
+      }
+    }
+    else if(inRun)
+    {
+      _span(gfx, (runStart < runEnd) ? runStart : runEnd, (runStart < runEnd) ? runEnd : runStart, runY, val);
+      inRun = false;
+    }
+
+    bit = (bit == last) ? 0x80000000 : (bit >> 1);
+    x += majorX;
+    y += majorY;
+    err -= minor;
+    if(err < 0)
+    {
+      if(steep)
+        x += sx;
+      else
+        y += sy;
+      err += major;
+    }
+  }
+
+  if(inRun)
+    _span(gfx, (runStart < runEnd) ? runStart : runEnd, (runStart < runEnd) ? runEnd : runStart, runY, val);
+
+  return MRT_STATUS_OK;
+}
+
+//most straight segments a single curve is split into
+#define MONO_GFX_BEZIER_MAX_STEPS 1024
+
+/**
+  *@brief state for stepping along a quadratic or cubic Bezier curve in equal steps of t with forward differences. Points are kept relative to
+  *       the start of the curve, with up to 32 fractional bits. Curves that reach far enough from their start to overflow that give up fractional bits
+  */
+typedef struct{
+  int64_t x, y;           //current point, relative to the start
+  int64_t dx, dy;         //first difference, added to the point each step
+  int64_t ddx, ddy;       //second difference
+  int64_t dddx, dddy;     //third difference, constant (0 for quadratic curves)
+  int frac;               //fractional bits
+}mono_gfx_bezier_t;
+
+/**
+  *@brief finds how many straight segments a curve needs to stay within MONO_GFX_BEZIER_TOLERANCE of its polyline. A polyline of n equal steps
+  *       strays from the curve by at most max|P[i] - 2P[i+1] + P[i+2]| / (4 n^2) for a quadratic curve, and 3 times that for a cubic one,
+  *       so gentle or small curves get few segments and tight ones get more
+  *@param p control points
+  *@param order 2 for quadratic, 3 for cubic
+  *@return number of segments
+  */
+static int _bezier_steps(const GFXpoint* p, int order)
+{
+  uint64_t most = 0;
+
+  //second differences of the control points, in 1/16 pixels
+  for(int i=0; i + 2 <= order; i++)
+  {
+    int64_t ddx = (int64_t)p[i].x - (2 * (int64_t)p[i + 1].x) + p[i + 2].x;
+    int64_t ddy = (int64_t)p[i].y - (2 * (int64_t)p[i + 1].y) + p[i + 2].y;
+
+    //bends this big need more than the most segments anyway, and squaring them could overflow
+    if((llabs(ddx) >= ((int64_t)1 << 26)) || (llabs(ddy) >= ((int64_t)1 << 26)))
+      return MONO_GFX_BEZIER_MAX_STEPS;
+
+    ddx *= 16;
+    ddy *= 16;
+    uint64_t d = (uint64_t)((ddx * ddx) + (ddy * ddy));
+
+    if(d > most)
+      most = d;
+  }
+
+  uint64_t len = _isqrt(most) + 1;
+  uint64_t need = ((((order == 3) ? 3 : 1) * len) + (4 * MONO_GFX_BEZIER_TOLERANCE) - 1) / (4 * MONO_GFX_BEZIER_TOLERANCE);
+  uint64_t steps = _isqrt(need);
+
+  if(steps * steps < need)
+    steps++;
+  if(steps < 1)
+    steps = 1;
+  if(steps > MONO_GFX_BEZIER_MAX_STEPS)
+    steps = MONO_GFX_BEZIER_MAX_STEPS;
+
+  return (int)steps;
+}
+
+//scales a polynomial coefficient by 2^frac / steps^power. The whole part and the remainder are scaled apart, so coef * 2^frac is never formed
+static inline int64_t _bezier_term(int64_t coef, int64_t steps, int power, int frac)
+{
+  int64_t div = steps;
+
+  while(--power > 0)
+    div *= steps;
+
+  return ((coef / div) * ((int64_t)1 << frac)) + (((coef % div) * ((int64_t)1 << frac)) / div);
+}
+
+/**
+  *@brief sets up a curve to be stepped. The curve is written as a t^3 + b t^2 + c t + d, and stepping t by 1/steps adds the
+  *       first difference, which is stepped by the second, and so on. The curve is taken relative to p[0], so d is 0
+  *@param curve ptr to curve state
+  *@param p control points
+  *@param order 2 for quadratic, 3 for cubic
+  *@param scale units per pixel of the points that come out (1 for pixels, 16 for 1/16 pixels)
+  *@param steps number of equal steps from the first point to the last
+  */
+static void _bezier_init(mono_gfx_bezier_t* curve, const GFXpoint* p, int order, int scale, int steps)
+{
+  int64_t a[2], b[2], c[2];
+  int64_t reach = 0;
+
+  for(int i=0; i < 2; i++)
+  {
+    int64_t p0 = 0;
+    int64_t p1 = (((i == 0) ? (int64_t)p[1].x - p[0].x : (int64_t)p[1].y - p[0].y)) * scale;
+    int64_t p2 = (((i == 0) ? (int64_t)p[2].x - p[0].x : (int64_t)p[2].y - p[0].y)) * scale;
+    int64_t p3 = 0;
+
+    if(order == 3)
+      p3 = (((i == 0) ? (int64_t)p[3].x - p[0].x : (int64_t)p[3].y - p[0].y)) * scale;
+
+    reach = (llabs(p1) > reach) ? llabs(p1) : reach;
+    reach = (llabs(p2) > reach) ? llabs(p2) : reach;
+    reach = (llabs(p3) > reach) ? llabs(p3) : reach;
+
+    if(order == 3)
+    {
+      a[i] = -p0 + (3 * p1) - (3 * p2) + p3;
+      b[i] = (3 * p0) - (6 * p1) + (3 * p2);
+      c[i] = (3 * p1) - (3 * p0);
+    }
+    else
+    {
+      a[i] = 0;
+      b[i] = p0 - (2 * p1) + p2;
+      c[i] = (2 * p1) - (2 * p0);
+    }
+  }
+
+  //the differences are at most 72 times the reach, so the reach scaled by 2^(frac + 7) has to stay below 2^62
+  int bits = 0;
+  while((bits < 62) && ((reach >> bits) != 0))
+    bits++;
+
+  int frac = 62 - 7 - bits;
+  curve->frac = (frac < 32) ? frac : 32;
+  curve->x = 0;
+  curve->y = 0;
+  curve->dx = _bezier_term(a[0], steps, 3, curve->frac) + _bezier_term(b[0], steps, 2, curve->frac) + _bezier_term(c[0], steps, 1, curve->frac);
+  curve->dy = _bezier_term(a[1], steps, 3, curve->frac) + _bezier_term(b[1], steps, 2, curve->frac) + _bezier_term(c[1], steps, 1, curve->frac);
+  curve->ddx = _bezier_term(6 * a[0], steps, 3, curve->frac) + _bezier_term(2 * b[0], steps, 2, curve->frac);
+  curve->ddy = _bezier_term(6 * a[1], steps, 3, curve->frac) + _bezier_term(2 * b[1], steps, 2, curve->frac);
+  curve->dddx = _bezier_term(6 * a[0], steps, 3, curve->frac);
+  curve->dddy = _bezier_term(6 * a[1], steps, 3, curve->frac);
+}
+
+//moves a curve one step along, and gets the point it lands on rounded to whole units, relative to the start of the curve
+static inline void _bezier_step(mono_gfx_bezier_t* curve, int64_t* x, int64_t* y)
+{
+  curve->x += curve->dx;
+  curve->y += curve->dy;
+  curve->dx += curve->ddx;
+  curve->dy += curve->ddy;
+  curve->ddx += curve->dddx;
+  curve->ddy += curve->dddy;
+
+  *x = (curve->x + ((int64_t)1 << (curve->frac - 1))) >> curve->frac;
+  *y = (curve->y + ((int64_t)1 << (curve->frac - 1))) >> curve->frac;
+}
+
+//checks that points make up a chain of curves of one order
+static inline bool _bezier_valid(int count, int order)
+{
+  return ((order == 2) || (order == 3)) && (count > order) && (((count - 1) % order) == 0);
+}
+
+mrt_status_t mono_gfx_draw_bezier(mono_gfx_t* gfx, const GFXpoint* points, int count, int order, uint8_t val)
+{
+  mono_gfx_bezier_t curve;
+  bool drawn = false;
+
+  if(!_bezier_valid(count, order))
+    return MRT_STATUS_ERROR;
+
+  int x = points[0].x;
+  int y = points[0].y;
+
+  for(int i=0; i + order < count; i += order)
+  {
+    const GFXpoint* p = &points[i];
+    int steps = _bezier_steps(p, order);
+    _bezier_init(&curve, p, order, 1, steps);
+
+    //each segment leaves off its end pixel, which the next one starts on
+    for(int s=1; s <= steps; s++)
+    {
+      int nx = p[order].x;
+      int ny = p[order].y;
+
+      //points between the ends are inside the hull of the control points, so they fit in an int
+      if(s < steps)
+      {
+        int64_t ox, oy;
+        _bezier_step(&curve, &ox, &oy);
+        nx = (int)(p[0].x + ox);
+        ny = (int)(p[0].y + oy);
+      }
+
+      if((nx != x) || (ny != y))
+      {
+        _line(gfx, x, y, nx, ny, true, val);
+        x = nx;
+        y = ny;
+        drawn = true;
+      }
+    }
+  }
+
+  //the last pixel, unless the curve closed back onto the first one
+  if(!drawn || (x != points[0].x) || (y != points[0].y))
+    _plot(gfx, x, y, val);
+
+  return MRT_STATUS_OK;
+}
+
+mrt_status_t mono_gfx_fill_bezier(mono_gfx_t* gfx, const GFXpoint* points, int count, int order, uint8_t rule, uint8_t val)
+{
+  GFXpoint outline[MONO_GFX_POLY_MAX_EDGES];
+  int steps[MONO_GFX_POLY_MAX_EDGES];
+  mono_gfx_bezier_t curve;
+  int n = 0;
+
+  if(!_bezier_valid(count, order))
+    return MRT_STATUS_ERROR;
+
+  int curves = (count - 1) / order;
+  if(curves > MONO_GFX_POLY_MAX_EDGES)
+    return MRT_STATUS_ERROR;
+
+  //the outline is in 1/16 pixels, so every point of it has to fit in an int at that scale
+  for(int i=0; i < count; i++)
+  {
+    if((llabs(points[i].x) > MONO_GFX_BEZIER_FILL_LIMIT) || (llabs(points[i].y) > MONO_GFX_BEZIER_FILL_LIMIT))
+      return MRT_STATUS_ERROR;
+  }
+
+  int total = 0;
+  for(int i=0; i < curves; i++)
+  {
+    steps[i] = _bezier_steps(&points[i * order], order);
+    total += steps[i];
+  }
+
+  //if the outline has more points than the filler takes, every curve gives up the same share of its extra segments
+  if(total > MONO_GFX_POLY_MAX_EDGES)
+  {
+    for(int i=0; i < curves; i++)
+      steps[i] = 1 + (int)(((int64_t)(steps[i] - 1) * (MONO_GFX_POLY_MAX_EDGES - curves)) / (total - curves));
+  }
+
+  //each curve adds its start and the points between, its end is the start of the next one. The last one joins back to the first
+  for(int i=0; i < curves; i++)
+  {
+    const GFXpoint* p = &points[i * order];
+    _bezier_init(&curve, p, order, 16, steps[i]);
+
+    outline[n].x = p[0].x * 16;
+    outline[n++].y = p[0].y * 16;
+    for(int s=1; s < steps[i]; s++)
+    {
+      int64_t ox, oy;
+      _bezier_step(&curve, &ox, &oy);
+      outline[n].x = (int)((p[0].x * 16) + ox);
+      outline[n++].y = (int)((p[0].y * 16) + oy);
+    }
+  }
+
+  return _fill_polygon(gfx, outline, n, 4, rule, gfx->mPattern, val);
+}
+
+/**
+  *@brief copies a run of bits between two places in a buffer that have the same offset within a byte
+  *@param buf ptr to buffer
+  *@param dstBit bit index to copy to
+  *@param srcBit bit index to copy from (srcBit % 8 must equal dstBit % 8)
+  *@param len number of bits to copy
+  */
+static void _copy_bits_aligned(uint8_t* buf, uint32_t dstBit, uint32_t srcBit, int len)
+{
+  uint8_t* d = &buf[dstBit / 8];
+  const uint8_t* s = &buf[srcBit / 8];
+  int head = dstBit % 8;
+  uint8_t mask;
+
+  //run starts and ends in the same byte
+  if(head + len <= 8)
+  {
+    mask = (0xFF >> head) & (0xFF << (8 - head - len));
+    *d = (*d & ~mask) | (*s & mask);
+    return;
+  }
+
+  if(head)
+  {
+    mask = 0xFF >> head;
+    *d = (*d & ~mask) | (*s & mask);
+    d++;
+    s++;
+    len -= 8 - head;
+  }
+
+  memmove(d, s, len / 8);
+
+  if(len % 8)
+  {
+    mask = 0xFF << (8 - (len % 8));
+    d += len / 8;
+    s += len / 8;
+    *d = (*d & ~mask) | (*s & mask);
+  }
+}
+
+mrt_status_t mono_gfx_scroll(mono_gfx_t* gfx, int x, int y, int w, int h, int dy, uint8_t val)
+{
+  //pixels can only be moved if we can read them back
+  if(!gfx->mBuffered)
+    return MRT_STATUS_ERROR;
+
+  //clip to canvas
+  if(x < 0)
+  {
+    w += x;
+    x = 0;
+  }
+  if(y < 0)
+  {
+    h += y;
+    y = 0;
+  }
+  if(x + w > gfx->mWidth)
+    w = gfx->mWidth - x;
+  if(y + h > gfx->mHeight)
+    h = gfx->mHeight - y;
+
+  if((w <= 0) || (h <= 0))
+    return MRT_STATUS_OK;
+
+  int dist = abs(dy);
+  if(dist >= h)
+  {
+    _fill_rect(gfx, x, x + w - 1, y, y + h - 1, NULL, val);
+    return MRT_STATUS_OK;
+  }
+
+  int moved = h - dist;
+  int dst = (dy > 0) ? y : y + dist;
+  int src = (dy > 0) ? y + dist : y;
+  uint32_t stride = gfx->mWidth;
+
+  if((x == 0) && (w == gfx->mWidth) && (((y * stride) % 8) == 0) && (((dist * stride) % 8) == 0) && (((h * stride) % 8) == 0))
+  {
+    //full width rows that start on byte boundaries are one contiguous block
+    memmove(&gfx->mBuffer[(dst * stride) / 8], &gfx->mBuffer[(src * stride) / 8], (moved * stride) / 8);
+  }
+  else
+  {
+    //copy row by row, in the order that reads each row before it is overwritten
+    for(int i=0; i < moved; i++)
+    {
+      int r = (dy > 0) ? i : moved - 1 - i;
+      uint32_t dstBit = ((dst + r) * stride) + x;
+      uint32_t srcBit = ((src + r) * stride) + x;
+
+      if(((dist * stride) % 8) == 0)
+      {
+        _copy_bits_aligned(gfx->mBuffer, dstBit, srcBit, w);
+      }
+      else
+      {
+        _span(gfx, x, x + w - 1, dst + r, MONO_GFX_PIXEL_OFF);
+        _blit_bits(gfx, x, dst + r, gfx->mBuffer, srcBit, w, MONO_GFX_PIXEL_ON);
+      }
+    }
+  }
+
+  //fill the rows that were uncovered
+  int top = (dy > 0) ? y + moved : y;
+  _fill_rect(gfx, x, x + w - 1, top, top + dist - 1, NULL, val);
+
+  return MRT_STATUS_OK;
+}
+
+//reads one pixel of a buffered canvas
+static inline bool _get_bit(const mono_gfx_t* gfx, uint32_t pos)
+{
+  return (gfx->mBuffer[pos / 8] >> (7 - (pos % 8))) & 1;
+}
+
+/**
+  *@brief finds the first pixel at or right of x on a row that is not v. Whole bytes of v are skipped at once
+  *@return x coord of the pixel, or mWidth if the row is v to the end
+  */
+static int _scan_right(const mono_gfx_t* gfx, int x, int y, bool v)
+{
+  uint32_t row = (uint32_t)y * gfx->mWidth;
+  uint32_t pos = row + x;
+  uint32_t end = row + gfx->mWidth;
+  uint8_t same = v ? 0xFF : 0x00;
+
+  while(pos < end)
+  {
+    if(((pos % 8) == 0) && (pos + 8 <= end) && (gfx->mBuffer[pos / 8] == same))
+    {
+      pos += 8;
+      continue;
+    }
+
+    if(_get_bit(gfx, pos) != v)
+      break;
+    pos++;
+  }
+
+  return pos - row;
+}
+
+/**
+  *@brief finds the first pixel at or left of x on a row that is not v. Whole bytes of v are skipped at once
+  *@return x coord of the pixel, or -1 if the row is v to the start
+  */
+static int _scan_left(const mono_gfx_t* gfx, int x, int y, bool v)
+{
+  int row = y * gfx->mWidth;
+  int pos = row + x;
+  uint8_t same = v ? 0xFF : 0x00;
+
+  while(pos >= row)
+  {
+    if(((pos % 8) == 7) && (pos - 7 >= row) && (gfx->mBuffer[pos / 8] == same))
+    {
+      pos -= 8;
+      continue;
+    }
+
+    if(_get_bit(gfx, pos) != v)
+      break;
+    pos--;
+  }
+
+  return pos - row;
+}
+
+//queues a filled run so the row next to it gets checked, unless that row is off the canvas or the stack is full
+static bool _push_fill(mono_gfx_t* gfx, GFXfillSpan* stack, int capacity, int* count, int y, int x0, int x1, int dy)
+{
+  if((y + dy < 0) || (y + dy >= gfx->mHeight))
+    return true;
+
+  if(*count >= capacity)
+    return false;
+
+  stack[*count].y = y;
+  stack[*count].x0 = x0;
+  stack[*count].x1 = x1;
+  stack[*count].dy = dy;
+  (*count)++;
+  return true;
+}
+
+mrt_status_t mono_gfx_flood_fill(mono_gfx_t* gfx, int x, int y, uint8_t val, GFXfillSpan* stack, int capacity)
+{
+  bool ok = true;
+  int count = 0;
+
+  if(!gfx->mBuffered)
+    return MRT_STATUS_ERROR;
+
+  if((x < 0) || (x >= gfx->mWidth) || (y < 0) || (y >= gfx->mHeight))
+    return MRT_STATUS_OK;
+
+  //the region is every pixel connected to the seed that has the same value
+  bool old = _get_bit(gfx, ((uint32_t)y * gfx->mWidth) + x);
+  bool fill = (val == MONO_GFX_PIXEL_INVERT) ? !old : (val != MONO_GFX_PIXEL_OFF);
+  if(fill == old)
+    return MRT_STATUS_OK;
+  val = fill ? MONO_GFX_PIXEL_ON : MONO_GFX_PIXEL_OFF;
+
+  int left = _scan_left(gfx, x, y, old) + 1;
+  int right = _scan_right(gfx, x, y, old) - 1;
+  _span(gfx, left, right, y, val);
+  ok &= _push_fill(gfx, stack, capacity, &count, y, left, right, 1);
+  ok &= _push_fill(gfx, stack, capacity, &count, y, left, right, -1);
+
+  while(count > 0)
+  {
+    GFXfillSpan parent = stack[--count];
+    int row = parent.y + parent.dy;
+    int cx = parent.x0;
+
+    //fill each run of the old value that touches the parent run
+    while(cx <= parent.x1)
+    {
+      cx = _scan_right(gfx, cx, row, !old);
+      if(cx > parent.x1)
+        break;
+
+      left = (cx == parent.x0) ? _scan_left(gfx, cx, row, old) + 1 : cx;
+      right = _scan_right(gfx, cx, row, old) - 1;
+      _span(gfx, left, right, row, val);
+
+      //keep going the same way, and turn back where the run spills past the ends of its parent
+      ok &= _push_fill(gfx, stack, capacity, &count, row, left, right, parent.dy);
+      if(left < parent.x0 - 1)
+        ok &= _push_fill(gfx, stack, capacity, &count, row, left, parent.x0 - 2, -parent.dy);
+      if(right > parent.x1 + 1)
+        ok &= _push_fill(gfx, stack, capacity, &count, row, parent.x1 + 2, right, -parent.dy);
+
+      cx = right + 2;
+    }
+  }
+
+  return ok ? MRT_STATUS_OK : MRT_STATUS_ERROR;
+}
 
 mrt_status_t mono_gfx_fill(mono_gfx_t* gfx, uint8_t val)
 {
   if(gfx->mBuffered)
   {
-    memset(gfx->mBuffer, val, gfx->mBufferSize);
+    if(gfx->mBufferSize > 0)
+      _span_bits(gfx->mBuffer, 0, (gfx->mWidth * gfx->mHeight) - 1, 0xFF, val);
   }
   else
   {
@@ -12,8 +12,45 @@
 #define MONO_GFX_PIXEL_ON 1
 #define MONO_GFX_PIXEL_INVERT 2
 
+#define MONO_GFX_STYLE_NORMAL 0x00
+#define MONO_GFX_STYLE_BOLD 0x01      //synthetic bold, each glyph row is smeared 1 pixel to the right
+#define MONO_GFX_STYLE_OBLIQUE 0x02   //synthetic oblique, rows are sheared right by 1 pixel per 4 rows above the baseline
+
+#define MONO_GFX_NUM_ZERO_PAD 0x01    //pad numbers out to their width with zeros instead of spaces
+#define MONO_GFX_NUM_SHOW_PLUS 0x02   //show a '+' on numbers that are not negative
+
+#define MONO_GFX_FILL_EVEN_ODD 0      //polygon fill rule, pixels inside an odd number of edges are filled
+#define MONO_GFX_FILL_NON_ZERO 1      //polygon fill rule, pixels the outline winds around are filled
+
+#define MONO_GFX_CAP_BUTT 0           //thick line ends at its end points
+#define MONO_GFX_CAP_SQUARE 1         //thick line runs on past its end points by half its width
+#define MONO_GFX_CAP_ROUND 2          //thick line ends in a half circle around its end points
+
+#define MONO_GFX_ROUND_LIMIT 16383     //largest radius circles, ellipses and rounded rects can have
+
+#ifndef MONO_GFX_POLY_MAX_EDGES
+#define MONO_GFX_POLY_MAX_EDGES 64    //most points mono_gfx_fill_polygon can take
+#endif
+
+#define MONO_GFX_GRAY_LEVELS 17       //number of brushes in mono_gfx_gray, from empty (0) to solid (16)
+
+#ifndef MONO_GFX_BEZIER_TOLERANCE
+#define MONO_GFX_BEZIER_TOLERANCE 4   //furthest a flattened curve can stray from the true one, in 1/16 pixels
+#endif
+
+#define MONO_GFX_BEZIER_FILL_LIMIT 134217727   //furthest a point given to mono_gfx_fill_bezier can be from 0,0 (INT_MAX / 16)
+
+#define MONO_GFX_ROTATE_0 0           //text rotation, clockwise
+#define MONO_GFX_ROTATE_90 1          //text runs down the screen
+#define MONO_GFX_ROTATE_180 2
+#define MONO_GFX_ROTATE_270 3         //text runs up the screen
+
 struct mono_gfx_struct;
+struct mono_gfx_text_cache_struct;
+struct mono_gfx_rot_cache_struct;
+struct mono_gfx_font_pager_struct;
 typedef mrt_status_t (*f_mono_gfx_write_pixel)(struct mono_gfx_struct* gfx, int x, int y, uint8_t val);
+typedef mrt_status_t (*f_mono_gfx_write_span)(struct mono_gfx_struct* gfx, int x0, int x1, int y, uint8_t val); //pointer to function that writes pixels x0 to x1 (inclusive) on one row
 typedef mrt_status_t (*f_mono_gfx_write)(struct mono_gfx_struct* gfx, int x, int y, uint8_t* data, int len, bool wrap); //pointer to write function
 typedef mrt_status_t (*f_mono_gfx_read)(struct mono_gfx_struct* gfx, int x, int y, uint8_t* data, int len, bool wrap); //pointer to write function
 
@@ -23,6 +60,24 @@ typedef struct{
 	int height;
 }GFXBmp;
 
+typedef struct{
+	int x;
+	int y;
+	int w;
+	int h;
+}GFXrect;
+
+typedef struct{
+	int x;
+	int y;
+}GFXpoint;
+
+typedef struct { // Run of a row filled by mono_gfx_flood_fill, waiting for the row next to it to be checked
+	int y;                  // Row of the run
+	int x0, x1;             // First and last x coord of the run
+	int8_t dy;              // Direction of the row to check (1 or -1)
+} GFXfillSpan;
+
 typedef struct { // Data stored PER GLYPH
 	int bitmapOffset;     // Pointer into GFXfont->bitmap
 	uint8_t  width, height;    // Bitmap dimensions in pixels
@@ -30,20 +85,119 @@ typedef struct { // Data stored PER GLYPH
 	int8_t   xOffset, yOffset; // Dist from cursor pos to UL corner
 } GFXglyph;
 
+typedef struct { // Contiguous run of codepoints outside of the first..last block
+	uint32_t first, last;   // Codepoint extents (inclusive)
+	uint16_t glyphIndex;    // Index in GFXfont->glyph of the glyph for 'first'
+} GFXrange;
+
+typedef struct { // Kerning adjustment for a pair of glyphs
+	uint16_t second;        // Index in GFXfont->glyph of the right hand glyph
+	int8_t   xAdjust;       // Added to the cursor before drawing the right hand glyph
+} GFXkernPair;
+
+typedef struct { // Optional pair kerning table for a font
+	const uint16_t*    index; // Offset into pairs for each left hand glyph index (glyphCount + 1 entries)
+	const GFXkernPair* pairs; // Pairs grouped by left hand glyph, sorted by 'second' within each group
+	uint16_t glyphCount;      // Number of glyphs covered by index
+} GFXkern;
+
+#define MONO_GFX_FONT_CACHE_DIGITS 0x01  // GFXfontCache::digits has been filled
+#define MONO_GFX_FONT_CACHE_ADVANCE 0x02 // GFXfontCache::fixedAdvance has been filled
+
+typedef struct { // Lookups that are worked out the first time a font is used and kept with it
+	const GFXglyph* digits[13]; // Glyphs for "0123456789-+." used to print numbers (NULL if the font does not have one)
+	uint8_t fixedAdvance;       // Advance shared by every glyph, 0 if the font is proportional or kerned
+	uint8_t flags;              // MONO_GFX_FONT_CACHE_ flags for the parts that have been filled (0 when the cache is new)
+} GFXfontCache;
+
 typedef struct { // Data stored for FONT AS A WHOLE:
 	uint8_t  *bitmap;      // Glyph bitmaps, concatenated
 	GFXglyph *glyph;       // Glyph array
 	uint8_t   first, last; // ASCII extents
 	uint8_t   yAdvance;    // Newline distance (y axis)
+	const GFXrange* ranges; // Optional extra codepoint ranges, sorted by 'first' (NULL if none)
+	uint16_t  rangeCount;   // Number of entries in ranges
+	const GFXkern* kern;    // Optional kerning table (NULL if none)
+	struct mono_gfx_font_pager_struct* pager; // Optional pager that bitmaps are read through when they are not in memory (NULL if none)
+	GFXfontCache* cache;    // Optional zeroed storage for lookups kept with the font (NULL to redo them on each call)
 } GFXfont;
 
+#ifndef MONO_GFX_CHAIN_CACHE_SIZE
+#define MONO_GFX_CHAIN_CACHE_SIZE 32  // Codepoints remembered by a font chain, must be a power of 2
+#endif
+
+typedef struct { // Font chain lookup result for one codepoint
+	uint32_t codepoint;     // Codepoint (0 if the slot is empty)
+	const GFXfont* font;    // Font that has a glyph for it (NULL if none do)
+	const GFXglyph* glyph;
+} GFXchainSlot;
+
+typedef struct { // Fallback fonts searched in order for characters the canvas font does not have
+	const GFXfont* const* fonts; // Fallback fonts
+	uint8_t count;               // Number of entries in fonts
+	const GFXfont* primary;      // Canvas font the cache was filled for
+	GFXchainSlot cache[MONO_GFX_CHAIN_CACHE_SIZE]; // Direct mapped on the low bits of the codepoint
+	uint32_t hits, misses;       // Cache statistics
+} GFXfontChain;
+
+#ifndef MONO_GFX_ROT_CACHE_ENTRIES
+#define MONO_GFX_ROT_CACHE_ENTRIES 32     //number of rotated glyphs to cache, two way set associative so must be even
+#endif
+
+#ifndef MONO_GFX_ROT_GLYPH_BYTES
+#define MONO_GFX_ROT_GLYPH_BYTES 160      //largest rotated glyph that can be cached, with dimensions padded to multiples of 8 (fits FreeSans18pt7b)
+#endif
+
+/**
+  *@brief cached copy of a glyph rotated by a quarter turn
+  */
+typedef struct{
+  const GFXglyph* glyph;    //glyph that was rotated (NULL if entry is empty)
+  uint8_t rotation;
+  uint8_t style;
+  int16_t width;            //size of the upright styled image
+  int16_t height;
+  int16_t minShift;         //left most oblique shift, the image starts at xOffset + minShift
+  uint8_t data[MONO_GFX_ROT_GLYPH_BYTES];   //rotated image, rows padded to whole bytes
+}mono_gfx_rot_entry_t;
+
+/**
+  *@brief cache of rotated glyphs for a canvas. A zeroed cache is empty, so a static one can be attached as is
+  */
+typedef struct mono_gfx_rot_cache_struct{
+  mono_gfx_rot_entry_t mEntries[MONO_GFX_ROT_CACHE_ENTRIES];
+  uint8_t mLast[MONO_GFX_ROT_CACHE_ENTRIES / 2];   //most recently used way of each set
+}mono_gfx_rot_cache_t;
+
+typedef struct { // Glyph in a prepared text run
+	const GFXglyph* glyph;  // Glyph to draw
+	const GFXfont* font;    // Font the glyph belongs to
+	int16_t x, y;           // Pen position relative to the run origin
+} GFXrunItem;
+
+typedef struct { // Text that has been laid out once so it can be redrawn without decoding or measuring
+	const GFXfont* font;    // Canvas font the run was laid out with
+	GFXrunItem* items;      // Caller allocated storage for glyphs
+	uint16_t capacity;      // Number of entries in items
+	uint16_t count;         // Number of glyphs in the run
+	GFXrect bounds;         // Ink bounding box relative to the run origin (before rotation)
+} GFXrun;
+
 typedef struct mono_gfx_struct{
   uint8_t* mBuffer;						 //buffer to store pixel data
   int mWidth;						 // width of buffer in pixels
   int mHeight;							//height of buffer in pixels
   uint32_t mBufferSize;					//size of buffer (in bytes)
 	const GFXfont* mFont;       				//font to use for printing
+	uint8_t mTextScale;							//integer scale factor for printing text (1 = normal size)
+	uint8_t mTextStyle;							//MONO_GFX_STYLE_ flags applied when printing text
+	uint8_t mTextRotation;					//MONO_GFX_ROTATE_ value for printing text
+	struct mono_gfx_text_cache_struct* mTextCache; //optional cache of rendered strings used by print (NULL for none)
+	struct mono_gfx_rot_cache_struct* mRotCache;   //optional cache of rotated glyphs, without one rotated text is drawn a pixel at a time (NULL for none)
+	GFXfontChain* mFontChain;				//optional fallback fonts for characters mFont does not have (NULL for none)
   f_mono_gfx_write_pixel fWritePixel; //pointer to write function
+	const uint8_t* mPattern;				//optional 8x8 brush for filled shapes, one byte per row, msb is the leftmost pixel (NULL for solid)
+	f_mono_gfx_write_span fWriteSpan;		//optional span write function for unbuffered canvases, used for fills instead of writing each pixel (NULL for none)
 	void* mDevice;								//void pointer to device for unbuffered implementation
 	bool mBuffered;
 } mono_gfx_t;
@@ -53,6 +207,11 @@ extern "C"
 {
 #endif
 
+/**
+  *@brief ordered dither brushes for mPattern. mono_gfx_gray[n] sets n out of every 16 pixels, spread evenly (4x4 Bayer matrix)
+  */
+extern const uint8_t mono_gfx_gray[MONO_GFX_GRAY_LEVELS][8];
+
 
 /**
   *@brief initializes a mono_gfx_t that manages its own buffer
@@ -112,16 +271,161 @@ mrt_status_t mono_gfx_write_buffer(mono_gfx_t* gfx, int x, int y, uint8_t* data,
 mrt_status_t mono_gfx_draw_bmp(mono_gfx_t* gfx, int x, int y,const GFXBmp* bmp, uint8_t val);
 
 /**
-  *@brief Draws rendered text to the buffer
+  *@brief Draws a bitmap to the buffer with each pixel scaled up to a scale x scale block
   *@param gfx ptr to mono_gfx_t descriptor
   *@param x x coord to begin drawing at
   *@param y y coord to begin drawing at
-  *@param text text to be written
+  *@param bmp bitmap to draw
+  *@param scale integer scale factor (1 = normal size)
+  *@param val pixel value on
+  *@return status of operation
+  */
+mrt_status_t mono_gfx_draw_bmp_scaled(mono_gfx_t* gfx, int x, int y,const GFXBmp* bmp, int scale, uint8_t val);
+
+/**
+  *@brief decodes the next codepoint from a UTF-8 string
+  *@param text ptr to string ptr, advanced past the decoded sequence
+  *@return codepoint, 0 at end of string, or 0xFFFD for a malformed sequence
+  */
+uint32_t mono_gfx_utf8_next(const char** text);
+
+/**
+  *@brief looks up the glyph for a codepoint
+  *@param font ptr to font
+  *@param codepoint unicode codepoint to look up
+  *@return ptr to glyph, or NULL if the font does not contain the codepoint
+  */
+const GFXglyph* mono_gfx_get_glyph(const GFXfont* font, uint32_t codepoint);
+
+/**
+  *@brief initializes a font chain. Attach it to a canvas by setting gfx->mFontChain
+  *@param chain ptr to chain
+  *@param fonts fallback fonts, searched in order after the canvas font
+  *@param count number of fallback fonts
+  */
+void mono_gfx_font_chain_init(GFXfontChain* chain, const GFXfont* const* fonts, uint8_t count);
+
+/**
+  *@brief finds the first font in a chain with a glyph for a codepoint. Results are cached, so repeated characters skip the search
+  *@param chain ptr to chain
+  *@param primary font searched before the fallbacks (usually gfx->mFont)
+  *@param codepoint unicode codepoint
+  *@param font ptr to store the font the glyph belongs to
+  *@return ptr to glyph, or NULL if no font in the chain has it
+  */
+const GFXglyph* mono_gfx_font_chain_get_glyph(GFXfontChain* chain, const GFXfont* primary, uint32_t codepoint, const GFXfont** font);
+
+/**
+  *@brief gets the kerning adjustment between two glyphs
+  *@param font ptr to font
+  *@param left glyph on the left
+  *@param right glyph on the right
+  *@return pixels to add to the cursor before drawing the right glyph
+  */
+int mono_gfx_get_kerning(const GFXfont* font, const GFXglyph* left, const GFXglyph* right);
+
+/**
+  *@brief checks if every glyph in a font has the same advance. The result is kept in the font's GFXfontCache if it has one
+  *@param font ptr to font
+  *@return advance of the font in pixels, or 0 if it is proportional or kerned
+  */
+int mono_gfx_fixed_advance(const GFXfont* font);
+
+/**
+  *@brief clears the rotated glyphs and rendered strings cached for a canvas. Both are keyed by font address, so this must be called for each canvas that drew with a font before the font is unloaded
+  *@param gfx ptr to gfx canvas
+  */
+void mono_gfx_flush_glyph_cache(mono_gfx_t* gfx);
+
+/**
+  *@brief Draws a single glyph with the current text scale, style, and rotation
+  *@param gfx ptr to mono_gfx_t descriptor
+  *@param font font that the glyph belongs to
+  *@param glyph ptr to glyph
+  *@param x x coord of pen
+  *@param y y coord of baseline
+  *@param val pixel value
+  *@return status of operation
+  */
+mrt_status_t mono_gfx_draw_glyph(mono_gfx_t* gfx, const GFXfont* font, const GFXglyph* glyph, int x, int y, uint8_t val);
+
+/**
+  *@brief Draws rendered text to the buffer. Text is scaled up by gfx->mTextScale, styled with gfx->mTextStyle, and rotated about x,y by gfx->mTextRotation
+  *@param gfx ptr to mono_gfx_t descriptor
+  *@param x x coord to begin drawing at
+  *@param y y coord to begin drawing at
+  *@param text text to be written (UTF-8)
   *@param val pixel value
   *@return status of operation
   */
 mrt_status_t mono_gfx_print(mono_gfx_t* gfx, int x, int y, const char * text, uint8_t val);
 
+/**
+  *@brief prints an integer without going through a format string. Digit glyphs are looked up once per call, or once per font if it has a GFXfontCache
+  *@param gfx ptr to mono_gfx_t descriptor
+  *@param x x coord to begin drawing at
+  *@param y y coord of baseline
+  *@param value number to print
+  *@param width minimum number of characters, padded on the left. Space padding is as wide as a digit
+  *@param flags MONO_GFX_NUM_ flags
+  *@param val pixel value
+  *@return MRT_STATUS_ERROR if a font has not been set
+  */
+mrt_status_t mono_gfx_print_int(mono_gfx_t* gfx, int x, int y, int32_t value, int width, uint8_t flags, uint8_t val);
+
+/**
+  *@brief prints a fixed point number, e.g. value 1234 with 2 decimals prints "12.34"
+  *@param gfx ptr to mono_gfx_t descriptor
+  *@param x x coord to begin drawing at
+  *@param y y coord of baseline
+  *@param value number to print, in units of 10^-decimals
+  *@param decimals digits after the point (0 - 10)
+  *@param width minimum number of characters including sign and point, padded on the left
+  *@param flags MONO_GFX_NUM_ flags
+  *@param val pixel value
+  *@return MRT_STATUS_ERROR if a font has not been set or decimals is out of range
+  */
+mrt_status_t mono_gfx_print_fixed(mono_gfx_t* gfx, int x, int y, int32_t value, int decimals, int width, uint8_t flags, uint8_t val);
+
+/**
+  *@brief gets the bounding box of the ink that text will draw
+  *@param gfx ptr to mono_gfx_t descriptor
+  *@param text text to be measured (UTF-8)
+  *@param rect ptr to store box, relative to the print origin and before rotation
+  *@return status of operation
+  */
+mrt_status_t mono_gfx_text_bounds(mono_gfx_t* gfx, const char * text, GFXrect* rect);
+
+/**
+  *@brief lays out text into a run that can be drawn repeatedly with mono_gfx_draw_run. Uses the current font, scale, and style
+  *@param gfx ptr to mono_gfx_t descriptor
+  *@param text text to be laid out (UTF-8)
+  *@param run ptr to run, items and capacity must be set by the caller
+  *@return MRT_STATUS_ERROR if there is no font or the run is too small (the run holds as many glyphs as fit)
+  */
+mrt_status_t mono_gfx_prepare_text(mono_gfx_t* gfx, const char * text, GFXrun* run);
+
+/**
+  *@brief draws a prepared text run. Canvas text settings should match the ones the run was prepared with
+  *@param gfx ptr to mono_gfx_t descriptor
+  *@param x x coord of run origin (same as x for mono_gfx_print)
+  *@param y y coord of run origin
+  *@param run ptr to prepared run
+  *@param val pixel value
+  *@return status of operation
+  */
+mrt_status_t mono_gfx_draw_run(mono_gfx_t* gfx, int x, int y, const GFXrun* run, uint8_t val);
+
+/**
+  *@brief measures the area that text will take up when printed
+  *@param gfx ptr to mono_gfx_t descriptor
+  *@param text text to be measured (UTF-8)
+  *@param w ptr to store width in pixels (widest line)
+  *@param h ptr to store height in pixels (number of lines * yAdvance)
+  *@return status of operation. For 90 and 270 degree text, w and h are swapped to match the screen
+  */
+mrt_status_t mono_gfx_measure(mono_gfx_t* gfx, const char * text, int* w, int* h);
+
 /**
   *@brief draws a rectangle
   *@param gfx ptr to gfx canvas
@@ -135,7 +439,35 @@ mrt_status_t mono_gfx_print(mono_gfx_t* gfx, int x, int y, const char * text, ui
 mrt_status_t mono_gfx_draw_line(mono_gfx_t* gfx, int x0, int y0, int x1, int y1, uint8_t val);
 
 /**
-  *@brief draws a rectangle
+  *@brief draws a line with a width. The stroke is filled as one polygon, so it has no gaps and no pixel is drawn twice
+  *@param gfx ptr to gfx canvas
+  *@param x0 x coord of p1
+  *@param y0 y coord of p1
+  *@param x1 x coord of p2
+  *@param y1 y coord of p2
+  *@param width width of the stroke in pixels, 1 or less draws the same as mono_gfx_draw_line
+  *@param cap MONO_GFX_CAP_ value for how the ends are drawn
+  *@param val pixel value
+  *@return MRT_STATUS_ERROR if width is more than 65535
+  */
+mrt_status_t mono_gfx_draw_line_thick(mono_gfx_t* gfx, int x0, int y0, int x1, int y1, int width, uint8_t cap, uint8_t val);
+
+/**
+  *@brief draws a dashed line. Each pixel from p1 to p2 takes the next bit of the pattern, and pixels whose bit is clear are left alone
+  *@param gfx ptr to gfx canvas
+  *@param x0 x coord of p1
+  *@param y0 y coord of p1
+  *@param x1 x coord of p2
+  *@param y1 y coord of p2
+  *@param pattern dash pattern, starting from the msb. 0xF0F0F0F0 is 4 on and 4 off
+  *@param length number of bits of the pattern to use before it repeats (1 to 32)
+  *@param val pixel value
+  *@return MRT_STATUS_ERROR if length is out of range
+  */
+mrt_status_t mono_gfx_draw_line_dashed(mono_gfx_t* gfx, int x0, int y0, int x1, int y1, uint32_t pattern, int length, uint8_t val);
+
+/**
+  *@brief draws a filled rectangle. If gfx->mPattern is set, only the pixels its brush covers are drawn
   *@param gfx ptr to gfx canvas
 	*@param x x coord to begin drawing at
   *@param y y coord to begin drawing at
@@ -146,6 +478,174 @@ mrt_status_t mono_gfx_draw_line(mono_gfx_t* gfx, int x0, int y0, int x1, int y1,
   */
 mrt_status_t mono_gfx_draw_rect(mono_gfx_t* gfx, int x, int y, int w, int h, uint8_t val);
 
+/**
+  *@brief draws the outline of a rectangle. Each pixel is drawn once, so outlines can be inverted
+  *@param gfx ptr to gfx canvas
+  *@param x x coord of left edge
+  *@param y y coord of top edge
+  *@param w width
+  *@param h height
+  *@param stroke width of the outline in pixels, drawn inside the rect
+  *@param val pixel value
+  *@return status of operation
+  */
+mrt_status_t mono_gfx_draw_rect_outline(mono_gfx_t* gfx, int x, int y, int w, int h, int stroke, uint8_t val);
+
+/**
+  *@brief draws the outline of a circle
+  *@param gfx ptr to gfx canvas
+  *@param x x coord of center
+  *@param y y coord of center
+  *@param r radius
+  *@param val pixel value
+  *@return MRT_STATUS_ERROR if r is more than MONO_GFX_ROUND_LIMIT
+  */
+mrt_status_t mono_gfx_draw_circle(mono_gfx_t* gfx, int x, int y, int r, uint8_t val);
+
+/**
+  *@brief draws a filled circle, with the gfx->mPattern brush if it is set
+  *@param gfx ptr to gfx canvas
+  *@param x x coord of center
+  *@param y y coord of center
+  *@param r radius
+  *@param val pixel value
+  *@return MRT_STATUS_ERROR if r is more than MONO_GFX_ROUND_LIMIT
+  */
+mrt_status_t mono_gfx_fill_circle(mono_gfx_t* gfx, int x, int y, int r, uint8_t val);
+
+/**
+  *@brief draws the outline of an axis aligned ellipse
+  *@param gfx ptr to gfx canvas
+  *@param x x coord of center
+  *@param y y coord of center
+  *@param rx horizontal radius
+  *@param ry vertical radius
+  *@param val pixel value
+  *@return MRT_STATUS_ERROR if rx or ry is more than MONO_GFX_ROUND_LIMIT
+  */
+mrt_status_t mono_gfx_draw_ellipse(mono_gfx_t* gfx, int x, int y, int rx, int ry, uint8_t val);
+
+/**
+  *@brief draws a filled axis aligned ellipse, with the gfx->mPattern brush if it is set
+  *@param gfx ptr to gfx canvas
+  *@param x x coord of center
+  *@param y y coord of center
+  *@param rx horizontal radius
+  *@param ry vertical radius
+  *@param val pixel value
+  *@return MRT_STATUS_ERROR if rx or ry is more than MONO_GFX_ROUND_LIMIT
+  */
+mrt_status_t mono_gfx_fill_ellipse(mono_gfx_t* gfx, int x, int y, int rx, int ry, uint8_t val);
+
+/**
+  *@brief draws the outline of a rectangle with rounded corners
+  *@param gfx ptr to gfx canvas
+  *@param x x coord of left edge
+  *@param y y coord of top edge
+  *@param w width
+  *@param h height
+  *@param r corner radius, limited to fit the rectangle
+  *@param val pixel value
+  *@return MRT_STATUS_ERROR if the corner radius, once fitted, is more than MONO_GFX_ROUND_LIMIT
+  */
+mrt_status_t mono_gfx_draw_round_rect(mono_gfx_t* gfx, int x, int y, int w, int h, int r, uint8_t val);
+
+/**
+  *@brief draws a filled rectangle with rounded corners, with the gfx->mPattern brush if it is set
+  *@param gfx ptr to gfx canvas
+  *@param x x coord of left edge
+  *@param y y coord of top edge
+  *@param w width
+  *@param h height
+  *@param r corner radius, limited to fit the rectangle
+  *@param val pixel value
+  *@return MRT_STATUS_ERROR if the corner radius, once fitted, is more than MONO_GFX_ROUND_LIMIT
+  */
+mrt_status_t mono_gfx_fill_round_rect(mono_gfx_t* gfx, int x, int y, int w, int h, int r, uint8_t val);
+
+/**
+  *@brief draws a filled triangle. Edges follow the same rule as mono_gfx_fill_polygon, so triangles that share an edge do not overlap.
+  *       Uses the gfx->mPattern brush if it is set
+  *@param gfx ptr to gfx canvas
+  *@param x0 x coord of p0
+  *@param y0 y coord of p0
+  *@param x1 x coord of p1
+  *@param y1 y coord of p1
+  *@param x2 x coord of p2
+  *@param y2 y coord of p2
+  *@param val pixel value
+  *@return status of operation
+  */
+mrt_status_t mono_gfx_fill_triangle(mono_gfx_t* gfx, int x0, int y0, int x1, int y1, int x2, int y2, uint8_t val);
+
+/**
+  *@brief draws a filled polygon, convex or not. A pixel is filled if its coord is inside the outline, or on a left or top edge.
+  *       This means polygons that share an edge do not overlap, and a rect from (0,0) to (10,10) fills 10x10 pixels.
+  *       Uses the gfx->mPattern brush if it is set
+  *@param gfx ptr to gfx canvas
+  *@param points corners of the polygon, the last one is joined back to the first
+  *@param count number of points
+  *@param rule MONO_GFX_FILL_EVEN_ODD or MONO_GFX_FILL_NON_ZERO, only matters where the outline crosses itself
+  *@param val pixel value
+  *@return MRT_STATUS_ERROR if there are more than MONO_GFX_POLY_MAX_EDGES points
+  */
+mrt_status_t mono_gfx_fill_polygon(mono_gfx_t* gfx, const GFXpoint* points, int count, uint8_t rule, uint8_t val);
+
+/**
+  *@brief draws a chain of quadratic or cubic Bezier curves. Each curve is split into straight segments, more where it bends
+  *       harder on screen, and the segments are joined so no pixel is drawn twice
+  *@param gfx ptr to gfx canvas
+  *@param points the start point, then for each curve its control points and end point. Each curve starts where the last one ended
+  *@param count number of points, 1 + (order * number of curves)
+  *@param order 2 for quadratic curves (1 control point each), 3 for cubic curves (2 control points each)
+  *@param val pixel value
+  *@return MRT_STATUS_ERROR if order is not 2 or 3, or count does not fit it
+  */
+mrt_status_t mono_gfx_draw_bezier(mono_gfx_t* gfx, const GFXpoint* points, int count, int order, uint8_t val);
+
+/**
+  *@brief draws a filled shape outlined by a chain of Bezier curves, with the gfx->mPattern brush if it is set. The last curve is
+  *       joined back to the start with a straight edge if it does not end there. The outline is flattened to 1/16 pixels and
+  *       filled by mono_gfx_fill_polygon, so it follows the same rules
+  *@param gfx ptr to gfx canvas
+  *@param points the start point, then for each curve its control points and end point
+  *@param count number of points, 1 + (order * number of curves)
+  *@param order 2 for quadratic curves, 3 for cubic curves
+  *@param rule MONO_GFX_FILL_EVEN_ODD or MONO_GFX_FILL_NON_ZERO
+  *@param val pixel value
+  *@return MRT_STATUS_ERROR if order or count are invalid, there are more than MONO_GFX_POLY_MAX_EDGES curves, or a point is more
+  *        than MONO_GFX_BEZIER_FILL_LIMIT from 0 on either axis. Outlines that need more points than the filler takes are flattened
+  *        more coarsely to fit
+  */
+mrt_status_t mono_gfx_fill_bezier(mono_gfx_t* gfx, const GFXpoint* points, int count, int order, uint8_t rule, uint8_t val);
+
+/**
+  *@brief moves the contents of an area of the canvas up or down, and fills the rows it uncovers. Only works on buffered canvases
+  *@param gfx ptr to gfx canvas
+  *@param x x coord of area
+  *@param y y coord of area
+  *@param w width of area
+  *@param h height of area
+  *@param dy number of rows to move the contents up (negative to move down)
+  *@param val pixel value for uncovered rows
+  *@return MRT_STATUS_ERROR if the canvas is unbuffered
+  */
+mrt_status_t mono_gfx_scroll(mono_gfx_t* gfx, int x, int y, int w, int h, int dy, uint8_t val);
+
+/**
+  *@brief fills the area of connected pixels around a point that are the same value as it. Works a run of a row at a time, using a
+  *       stack given by the caller instead of recursion. Only works on buffered canvases, and always fills solid (gfx->mPattern is not used)
+  *@param gfx ptr to gfx canvas
+  *@param x x coord of seed point
+  *@param y y coord of seed point
+  *@param val pixel value
+  *@param stack storage for runs waiting to be checked
+  *@param capacity number of entries in stack. Simple shapes need a few, each notch or hole in the area can add a couple more
+  *@return MRT_STATUS_ERROR if the canvas is unbuffered, or if the stack ran out. In that case the part of the area that was reached is filled,
+  *        and calling again from a point that was missed continues the fill
+  */
+mrt_status_t mono_gfx_flood_fill(mono_gfx_t* gfx, int x, int y, uint8_t val, GFXfillSpan* stack, int capacity);
+
 /**
   *@brief fill buffer with value
   *@param gfx ptr to gfxice
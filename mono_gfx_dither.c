@@ -0,0 +1,286 @@
+/**
+  *@file mono_gfx_dither.c
+  *@brief converts 8 bit grayscale images to packed 1 bit bitmaps that can be drawn with mono_gfx_draw_bmp
+  *@author Jason Berger
+  *@date 10/18/2026
+  */
+
+#include "mono_gfx_dither.h"
+#include "string.h"
+
+//threshold and ordered dithering compare a whole vector of pixels at once when the target has SIMD. Define MONO_GFX_DITHER_NO_SIMD to always use the portable code
+#if !defined(MONO_GFX_DITHER_NO_SIMD) && defined(__AVX2__)
+#include <immintrin.h>
+#define MONO_GFX_DITHER_SIMD 32
+#elif !defined(MONO_GFX_DITHER_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64))
+#include <emmintrin.h>
+#define MONO_GFX_DITHER_SIMD 16
+#elif !defined(MONO_GFX_DITHER_NO_SIMD) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#include <arm_neon.h>
+#define MONO_GFX_DITHER_SIMD 16
+#endif
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+//8x8 Bayer matrix scaled to gray levels. A pixel is set if it is at or above its entry, so level g sets about g/4 of every 64 pixels
+static const uint8_t _bayer[8][8] = {
+  {  2, 130,  34, 162,  10, 138,  42, 170},
+  {194,  66, 226,  98, 202,  74, 234, 106},
+  { 50, 178,  18, 146,  58, 186,  26, 154},
+  {242, 114, 210,  82, 250, 122, 218,  90},
+  { 14, 142,  46, 174,   6, 134,  38, 166},
+  {206,  78, 238, 110, 198,  70, 230, 102},
+  { 62, 190,  30, 158,  54, 182,  22, 150},
+  {254, 126, 222,  94, 246, 118, 214,  86}
+};
+
+/**
+  *@brief writes up to 8 bits into the packed output. Output is written in order, so bits after the ones written are not kept
+  *@param out ptr to packed output
+  *@param bit index of the first bit to write
+  *@param bits bits to write, msb first
+  *@param n number of bits to write
+  */
+static inline void _put_bits(uint8_t* out, uint32_t bit, uint8_t bits, int n)
+{
+  uint8_t* p = &out[bit / 8];
+  int shift = bit % 8;
+
+  bits &= (uint8_t)(0xFF << (8 - n));
+
+  if(shift == 0)
+  {
+    *p = bits;
+    return;
+  }
+
+  *p = (uint8_t)((*p & (0xFF << (8 - shift))) | (bits >> shift));
+  if(n > 8 - shift)
+    p[1] = (uint8_t)(bits << (8 - shift));
+}
+
+#ifdef MONO_GFX_DITHER_SIMD
+/**
+  *@brief packs as many whole vectors of a row as fit by comparing them against a repeating row of 8 thresholds
+  *@param gray ptr to gray pixels of the row
+  *@param width width of row in pixels
+  *@param thresh 8 thresholds, pixel x is set if it is at or above thresh[x % 8]
+  *@param out ptr to packed output
+  *@param bit index in out of the first pixel of the row
+  *@return number of pixels packed
+  */
+static int _threshold_simd(const uint8_t* gray, int width, const uint8_t* thresh, uint8_t* out, uint32_t bit)
+{
+  int x = 0;
+
+#if defined(__AVX2__)
+  //movemask takes the msb of each byte from byte 0 up, so pixels are reversed within each group of 8 to come out msb first
+  const __m256i reverse = _mm256_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8,
+                                           7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+  int64_t row;
+  memcpy(&row, thresh, sizeof(row));
+  __m256i t = _mm256_shuffle_epi8(_mm256_set1_epi64x(row), reverse);
+
+  for(; x + 32 <= width; x += 32)
+  {
+    __m256i g = _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i*)&gray[x]), reverse);
+    uint32_t mask = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_max_epu8(g, t), g));
+
+    for(int i=0; i < 4; i++)
+      _put_bits(out, bit + x + (i * 8), (uint8_t)(mask >> (i * 8)), 8);
+  }
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+  //each set lane keeps its bit weight, then pairwise adds fold every 8 lanes into one byte
+  static const uint8_t weights[16] = {0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01, 0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01};
+  uint8x8_t t8 = vld1_u8(thresh);
+  uint8x16_t t = vcombine_u8(t8, t8);
+  uint8x16_t w = vld1q_u8(weights);
+
+  for(; x + 16 <= width; x += 16)
+  {
+    uint8x16_t set = vandq_u8(vcgeq_u8(vld1q_u8(&gray[x]), t), w);
+    uint8x8_t sum = vpadd_u8(vget_low_u8(set), vget_high_u8(set));
+    sum = vpadd_u8(sum, sum);
+    sum = vpadd_u8(sum, sum);
+
+    _put_bits(out, bit + x, vget_lane_u8(sum, 0), 8);
+    _put_bits(out, bit + x + 8, vget_lane_u8(sum, 1), 8);
+  }
+#else
+  __m128i t = _mm_loadl_epi64((const __m128i*)thresh);
+  t = _mm_unpacklo_epi64(t, t);
+
+  //movemask takes the msb of each byte from byte 0 up, so pixels are reversed within each group of 8 to come out msb first
+  t = _mm_shufflehi_epi16(_mm_shufflelo_epi16(t, 0x1B), 0x1B);
+  t = _mm_or_si128(_mm_slli_epi16(t, 8), _mm_srli_epi16(t, 8));
+
+  for(; x + 16 <= width; x += 16)
+  {
+    __m128i g = _mm_loadu_si128((const __m128i*)&gray[x]);
+    g = _mm_shufflehi_epi16(_mm_shufflelo_epi16(g, 0x1B), 0x1B);
+    g = _mm_or_si128(_mm_slli_epi16(g, 8), _mm_srli_epi16(g, 8));
+    int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(g, t), g));
+
+    _put_bits(out, bit + x, (uint8_t)mask, 8);
+    _put_bits(out, bit + x + 8, (uint8_t)(mask >> 8), 8);
+  }
+#endif
+
+  return x;
+}
+#endif
+
+/**
+  *@brief packs a row by comparing it against a repeating row of 8 thresholds
+  *@param dither ptr to conversion
+  *@param gray ptr to gray pixels of the row
+  *@param thresh 8 thresholds, pixel x is set if it is at or above thresh[x % 8]
+  */
+static void _threshold_row(mono_gfx_dither_t* dither, const uint8_t* gray, const uint8_t* thresh)
+{
+  uint32_t bit = (uint32_t)dither->mRow * dither->mWidth;
+  int x = 0;
+
+#ifdef MONO_GFX_DITHER_SIMD
+  x = _threshold_simd(gray, dither->mWidth, thresh, dither->mOut, bit);
+#endif
+
+  //whatever is left a byte at a time
+  for(; x < dither->mWidth; x += 8)
+  {
+    int n = (dither->mWidth - x < 8) ? dither->mWidth - x : 8;
+    uint8_t bits = 0;
+
+    for(int i=0; i < n; i++)
+    {
+      if(gray[x + i] >= thresh[i])
+        bits |= 0x80 >> i;
+    }
+    _put_bits(dither->mOut, bit + x, bits, n);
+  }
+}
+
+/**
+  *@brief packs a row with error diffusion. Error is kept in units of 1/16 (Floyd-Steinberg) or 1/8 (Atkinson) of a gray level so none is lost to rounding
+  *@param dither ptr to conversion
+  *@param gray ptr to gray pixels of the row
+  */
+static void _diffuse_row(mono_gfx_dither_t* dither, const uint8_t* gray)
+{
+  int len = dither->mWidth + 4;
+  uint32_t bit = (uint32_t)dither->mRow * dither->mWidth;
+  bool atkinson = (dither->mMethod == MONO_GFX_DITHER_ATKINSON);
+  int shift = atkinson ? 3 : 4;
+
+  //three rows of error are kept in turn, each with 2 entries of padding on both sides for error that falls off the edges
+  int16_t* e0 = &dither->mErr[((dither->mRow) % 3) * len + 2];
+  int16_t* e1 = &dither->mErr[((dither->mRow + 1) % 3) * len + 2];
+  int16_t* e2 = &dither->mErr[((dither->mRow + 2) % 3) * len + 2];
+  uint8_t bits = 0;
+
+  //error for the next pixels on this row is carried in locals, so each pixel does not wait on the store from the one before it
+  int right = 0;
+  int right2 = 0;
+
+  for(int x=0; x < dither->mWidth; x++)
+  {
+    int v = gray[x] + ((e0[x] + right + (1 << (shift - 1))) >> shift);
+    int set = (v >= 128);
+    int err = v - (set * 255);
+
+    bits |= set << (7 - (x % 8));
+
+    if(atkinson)
+    {
+      right = right2 + err;
+      right2 = err;
+      e1[x - 1] += err;
+      e1[x] += err;
+      e1[x + 1] += err;
+      e2[x] += err;
+    }
+    else
+    {
+      right = err * 7;
+      e1[x - 1] += err * 3;
+      e1[x] += err * 5;
+      e1[x + 1] += err;
+    }
+
+    if(((x % 8) == 7) || (x == dither->mWidth - 1))
+    {
+      _put_bits(dither->mOut, bit + (x & ~7), bits, (x % 8) + 1);
+      bits = 0;
+    }
+  }
+
+  //this row's slot is reused for the row 3 down
+  memset(e0 - 2, 0, len * sizeof(int16_t));
+}
+
+mrt_status_t mono_gfx_dither_init(mono_gfx_dither_t* dither, uint8_t* out, int width, int height, uint8_t method, int16_t* err)
+{
+  if(method > MONO_GFX_DITHER_ATKINSON)
+    return MRT_STATUS_ERROR;
+
+  dither->mOut = out;
+  dither->mWidth = width;
+  dither->mHeight = height;
+  dither->mMethod = method;
+  dither->mLevel = 128;
+  dither->mErr = err;
+  dither->mRow = 0;
+
+  if(method >= MONO_GFX_DITHER_FLOYD_STEINBERG)
+  {
+    if(err == NULL)
+      return MRT_STATUS_ERROR;
+
+    memset(err, 0, MONO_GFX_DITHER_ERR_LEN(width) * sizeof(int16_t));
+  }
+
+  return MRT_STATUS_OK;
+}
+
+mrt_status_t mono_gfx_dither_row(mono_gfx_dither_t* dither, const uint8_t* gray)
+{
+  uint8_t level[8];
+
+  if(dither->mRow >= dither->mHeight)
+    return MRT_STATUS_ERROR;
+
+  switch(dither->mMethod)
+  {
+    case MONO_GFX_DITHER_THRESHOLD:
+      memset(level, dither->mLevel, sizeof(level));
+      _threshold_row(dither, gray, level);
+      break;
+    case MONO_GFX_DITHER_BAYER:
+      _threshold_row(dither, gray, _bayer[dither->mRow % 8]);
+      break;
+    default:
+      _diffuse_row(dither, gray);
+      break;
+  }
+
+  dither->mRow++;
+  return MRT_STATUS_OK;
+}
+
+mrt_status_t mono_gfx_dither_image(mono_gfx_dither_t* dither, const uint8_t* gray, int stride)
+{
+  while(dither->mRow < dither->mHeight)
+  {
+    mono_gfx_dither_row(dither, gray);
+    gray += stride;
+  }
+
+  return MRT_STATUS_OK;
+}
+
+#ifdef __cplusplus
+}
+#endif
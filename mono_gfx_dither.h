@@ -0,0 +1,64 @@
+/**
+  *@file mono_gfx_dither.h
+  *@brief converts 8 bit grayscale images to packed 1 bit bitmaps that can be drawn with mono_gfx_draw_bmp
+  *@author Jason Berger
+  *@date 10/18/2026
+  */
+#pragma once
+
+#include "mono_gfx.h"
+
+#define MONO_GFX_DITHER_THRESHOLD 0           //pixels at or above mLevel are set
+#define MONO_GFX_DITHER_BAYER 1               //ordered dither with an 8x8 Bayer matrix
+#define MONO_GFX_DITHER_FLOYD_STEINBERG 2     //error diffusion, all of the error is passed on
+#define MONO_GFX_DITHER_ATKINSON 3            //error diffusion, 3/4 of the error is passed on. Higher contrast and cleaner flat areas, but grays near black or white go solid
+
+#define MONO_GFX_DITHER_ERR_LEN(width) (3 * ((width) + 4))   //entries needed in the error buffer for error diffusion
+
+typedef struct{
+	uint8_t* mOut;                //packed output, rows back to back the same as GFXBmp. (width * height + 7) / 8 bytes
+	int mWidth;                   //width of image in pixels
+	int mHeight;                  //height of image in pixels
+	uint8_t mMethod;              //MONO_GFX_DITHER_ value
+	uint8_t mLevel;               //gray level that pixels are set at for MONO_GFX_DITHER_THRESHOLD (default 128)
+	int16_t* mErr;                //error carried to the next rows, only used for error diffusion
+	int mRow;                     //next row to be converted
+}mono_gfx_dither_t;
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+  *@brief initializes a conversion. Rows are then fed in top to bottom with mono_gfx_dither_row, or all at once with mono_gfx_dither_image
+  *@param dither ptr to conversion
+  *@param out buffer for packed output, (width * height + 7) / 8 bytes. Set pixels are the bright ones
+  *@param width width of image in pixels
+  *@param height height of image in pixels
+  *@param method MONO_GFX_DITHER_ value
+  *@param err buffer of MONO_GFX_DITHER_ERR_LEN(width) entries for error diffusion, can be NULL for threshold and ordered dithering
+  *@return MRT_STATUS_ERROR if the method is unknown or needs an error buffer that was not given
+  */
+mrt_status_t mono_gfx_dither_init(mono_gfx_dither_t* dither, uint8_t* out, int width, int height, uint8_t method, int16_t* err);
+
+/**
+  *@brief converts the next row of the image. Only the error of the next two rows is kept, so images can be streamed in from a camera or file
+  *@param dither ptr to conversion
+  *@param gray width 8 bit gray pixels, 0 is black
+  *@return MRT_STATUS_ERROR if every row has already been converted
+  */
+mrt_status_t mono_gfx_dither_row(mono_gfx_dither_t* dither, const uint8_t* gray);
+
+/**
+  *@brief converts every remaining row of an image in memory
+  *@param dither ptr to conversion
+  *@param gray 8 bit gray pixels of the first remaining row
+  *@param stride bytes from the start of one row to the next
+  *@return status of operation
+  */
+mrt_status_t mono_gfx_dither_image(mono_gfx_dither_t* dither, const uint8_t* gray, int stride);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,349 @@
+/**
+  *@file mono_gfx_font_file.c
+  *@brief loads GFXfonts from memory mapped binary font files
+  *@author Jason Berger
+  *@date 10/18/2026
+  */
+
+//madvise and pread are POSIX/BSD extensions, which strict ISO C modes (-std=c99) hide unless asked for before any header.
+//_DARWIN_C_SOURCE keeps madvise visible on macOS once _POSIX_C_SOURCE is set
+#ifndef _DEFAULT_SOURCE
+#define _DEFAULT_SOURCE
+#endif
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+#ifndef _DARWIN_C_SOURCE
+#define _DARWIN_C_SOURCE
+#endif
+
+#include "mono_gfx_font_file.h"
+#include "string.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+//checks that a table of count*size bytes at offset is aligned and fits in the file
+static bool _table_ok(size_t fileSize, uint32_t offset, uint32_t count, uint32_t size)
+{
+  if((offset & 3) != 0)
+    return false;
+
+  uint64_t end = (uint64_t)offset + ((uint64_t)count * size);
+  return (offset <= fileSize) && (end <= fileSize);
+}
+
+/**
+  *@brief checks the header and tables of a font file and points the font at them
+  *@param file ptr to font file object, mMap holds at least the first tableSize bytes of the file
+  *@param tableSize number of bytes at mMap that the header and glyph, range, and kerning tables have to fit in
+  */
+static mrt_status_t _validate(mono_gfx_font_file_t* file, size_t tableSize)
+{
+  const uint8_t* base = (const uint8_t*) file->mMap;
+  const mono_gfx_font_file_header_t* hdr = (const mono_gfx_font_file_header_t*) base;
+
+  if(tableSize < sizeof(mono_gfx_font_file_header_t))
+    return MRT_STATUS_ERROR;
+
+  //make sure the file was written with the same struct layout we are going to use it with
+  if( (memcmp(hdr->magic, MONO_GFX_FONT_FILE_MAGIC, 4) != 0) ||
+      (hdr->version != MONO_GFX_FONT_FILE_VERSION) ||
+      (hdr->headerSize != sizeof(mono_gfx_font_file_header_t)) ||
+      (hdr->byteOrder != MONO_GFX_FONT_FILE_BYTE_ORDER) ||
+      (hdr->glyphSize != sizeof(GFXglyph)) ||
+      (hdr->rangeSize != sizeof(GFXrange)) ||
+      (hdr->kernPairSize != sizeof(GFXkernPair)) )
+    return MRT_STATUS_ERROR;
+
+  //counts have to fit in the GFXfont fields they are copied to
+  if((hdr->glyphCount > UINT16_MAX) || (hdr->rangeCount > UINT16_MAX))
+    return MRT_STATUS_ERROR;
+
+  if( !_table_ok(tableSize, hdr->glyphOffset, hdr->glyphCount, sizeof(GFXglyph)) ||
+      !_table_ok(tableSize, hdr->rangeOffset, hdr->rangeCount, sizeof(GFXrange)) ||
+      !_table_ok(file->mSize, hdr->bitmapOffset, hdr->bitmapSize, 1))
+    return MRT_STATUS_ERROR;
+
+  const GFXglyph* glyphs = (const GFXglyph*)(base + hdr->glyphOffset);
+  const GFXrange* ranges = (const GFXrange*)(base + hdr->rangeOffset);
+
+  //primary block has to be covered by the glyph table
+  if((hdr->first <= hdr->last) && ((uint32_t)(hdr->last - hdr->first) >= hdr->glyphCount))
+    return MRT_STATUS_ERROR;
+
+  //ranges have to be sorted, non overlapping, and index real glyphs
+  for(uint32_t i=0; i < hdr->rangeCount; i++)
+  {
+    if( (ranges[i].first > ranges[i].last) ||
+        ((uint64_t)ranges[i].glyphIndex + (ranges[i].last - ranges[i].first) >= hdr->glyphCount) ||
+        ((i > 0) && (ranges[i].first <= ranges[i-1].last)) )
+      return MRT_STATUS_ERROR;
+  }
+
+  //every glyph bitmap has to be inside of the bitmap table. This only reads the glyph table, the bitmap pages are left alone
+  for(uint32_t i=0; i < hdr->glyphCount; i++)
+  {
+    uint32_t len = (((uint32_t)glyphs[i].width * glyphs[i].height) + 7) / 8;
+    if((glyphs[i].bitmapOffset < 0) || ((uint64_t)glyphs[i].bitmapOffset + len > hdr->bitmapSize))
+      return MRT_STATUS_ERROR;
+  }
+
+  file->mFont.bitmap = (uint8_t*)(base + hdr->bitmapOffset);
+  file->mFont.glyph = (GFXglyph*)glyphs;
+  file->mFont.first = hdr->first;
+  file->mFont.last = hdr->last;
+  file->mFont.yAdvance = hdr->yAdvance;
+  file->mFont.ranges = (hdr->rangeCount > 0) ? ranges : NULL;
+  file->mFont.rangeCount = hdr->rangeCount;
+  file->mFont.kern = NULL;
+  file->mFont.cache = &file->mCache;
+
+  if(hdr->kernPairCount > 0)
+  {
+    if( !_table_ok(tableSize, hdr->kernIndexOffset, hdr->glyphCount + 1, sizeof(uint16_t)) ||
+        !_table_ok(tableSize, hdr->kernPairOffset, hdr->kernPairCount, sizeof(GFXkernPair)))
+      return MRT_STATUS_ERROR;
+
+    const uint16_t* index = (const uint16_t*)(base + hdr->kernIndexOffset);
+    const GFXkernPair* pairs = (const GFXkernPair*)(base + hdr->kernPairOffset);
+
+    if((index[0] != 0) || (index[hdr->glyphCount] != hdr->kernPairCount))
+      return MRT_STATUS_ERROR;
+
+    for(uint32_t i=0; i < hdr->glyphCount; i++)
+    {
+      if(index[i] > index[i+1])
+        return MRT_STATUS_ERROR;
+    }
+
+    file->mKern.index = index;
+    file->mKern.pairs = pairs;
+    file->mKern.glyphCount = hdr->glyphCount;
+    file->mFont.kern = &file->mKern;
+  }
+
+  return MRT_STATUS_OK;
+}
+
+mrt_status_t mono_gfx_font_file_open(mono_gfx_font_file_t* file, const char* path)
+{
+  struct stat st;
+  int fd;
+
+  memset(file, 0, sizeof(mono_gfx_font_file_t));
+
+  fd = open(path, O_RDONLY);
+  if(fd < 0)
+    return MRT_STATUS_ERROR;
+
+  if((fstat(fd, &st) != 0) || (st.st_size <= 0))
+  {
+    close(fd);
+    return MRT_STATUS_ERROR;
+  }
+
+  file->mSize = st.st_size;
+  file->mMap = mmap(NULL, file->mSize, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd); //mapping stays valid after the descriptor is closed
+
+  if(file->mMap == MAP_FAILED)
+  {
+    file->mMap = NULL;
+    return MRT_STATUS_ERROR;
+  }
+
+  //glyphs are drawn in whatever order the text needs them, so dont let the kernel read ahead the whole bitmap
+  madvise(file->mMap, file->mSize, MADV_RANDOM);
+
+  if(_validate(file, file->mSize) != MRT_STATUS_OK)
+  {
+    mono_gfx_font_file_close(file);
+    return MRT_STATUS_ERROR;
+  }
+
+  return MRT_STATUS_OK;
+}
+
+//pager read callback for paged font files
+static mrt_status_t _pread(void* ctx, uint32_t offset, uint8_t* data, uint32_t len)
+{
+  mono_gfx_font_file_t* file = (mono_gfx_font_file_t*) ctx;
+
+  return (pread(file->mFd, data, len, offset) == (ssize_t)len) ? MRT_STATUS_OK : MRT_STATUS_ERROR;
+}
+
+mrt_status_t mono_gfx_font_file_open_paged(mono_gfx_font_file_t* file, const char* path, mono_gfx_font_pager_t* pager)
+{
+  mono_gfx_font_file_header_t hdr;
+  struct stat st;
+
+  memset(file, 0, sizeof(mono_gfx_font_file_t));
+  file->mFd = open(path, O_RDONLY);
+  if(file->mFd < 0)
+    return MRT_STATUS_ERROR;
+  file->mPager = pager;
+
+  //everything in front of the bitmap table is read in, the bitmap stays in the file
+  if( (fstat(file->mFd, &st) != 0) ||
+      (pread(file->mFd, &hdr, sizeof(hdr), 0) != sizeof(hdr)) ||
+      (hdr.bitmapOffset < sizeof(hdr)) || (hdr.bitmapOffset > (uint64_t)st.st_size) )
+  {
+    mono_gfx_font_file_close(file);
+    return MRT_STATUS_ERROR;
+  }
+
+  file->mSize = st.st_size;
+  file->mMap = malloc(hdr.bitmapOffset);
+
+  if( (file->mMap == NULL) ||
+      (pread(file->mFd, file->mMap, hdr.bitmapOffset, 0) != (ssize_t)hdr.bitmapOffset) ||
+      (_validate(file, hdr.bitmapOffset) != MRT_STATUS_OK) )
+  {
+    mono_gfx_font_file_close(file);
+    return MRT_STATUS_ERROR;
+  }
+
+  mono_gfx_font_pager_init(pager, &_pread, file, hdr.bitmapOffset, hdr.bitmapSize);
+  file->mFont.bitmap = NULL;
+  file->mFont.pager = pager;
+
+  return MRT_STATUS_OK;
+}
+
+mrt_status_t mono_gfx_font_file_close(mono_gfx_font_file_t* file)
+{
+  if(file->mPager != NULL)
+  {
+    free(file->mMap);
+    close(file->mFd);
+  }
+  else if(file->mMap != NULL)
+  {
+    munmap(file->mMap, file->mSize);
+  }
+
+  memset(file, 0, sizeof(mono_gfx_font_file_t));
+
+  return MRT_STATUS_OK;
+}
+
+//pads the file out to the next 4 byte boundary and returns the new offset
+static uint32_t _align(FILE* fp, uint32_t offset)
+{
+  while(offset & 3)
+  {
+    fputc(0, fp);
+    offset++;
+  }
+  return offset;
+}
+
+mrt_status_t mono_gfx_font_file_write(const GFXfont* font, const char* path)
+{
+  mono_gfx_font_file_header_t hdr;
+  uint32_t glyphCount = 0;
+  uint32_t offset;
+  FILE* fp;
+
+  //glyph table size is not stored in GFXfont, so work it out from the blocks that index into it
+  if(font->first <= font->last)
+    glyphCount = (font->last - font->first) + 1;
+
+  for(int i=0; i < font->rangeCount; i++)
+  {
+    uint32_t end = font->ranges[i].glyphIndex + (font->ranges[i].last - font->ranges[i].first) + 1;
+    if(end > glyphCount)
+      glyphCount = end;
+  }
+
+  if(((font->kern != NULL) && (font->kern->glyphCount > glyphCount)) || (font->pager != NULL))
+    return MRT_STATUS_ERROR;
+
+  memset(&hdr, 0, sizeof(hdr));
+  memcpy(hdr.magic, MONO_GFX_FONT_FILE_MAGIC, 4);
+  hdr.version = MONO_GFX_FONT_FILE_VERSION;
+  hdr.headerSize = sizeof(mono_gfx_font_file_header_t);
+  hdr.byteOrder = MONO_GFX_FONT_FILE_BYTE_ORDER;
+  hdr.glyphSize = sizeof(GFXglyph);
+  hdr.rangeSize = sizeof(GFXrange);
+  hdr.kernPairSize = sizeof(GFXkernPair);
+  hdr.first = font->first;
+  hdr.last = font->last;
+  hdr.yAdvance = font->yAdvance;
+  hdr.glyphCount = glyphCount;
+  hdr.rangeCount = (font->ranges != NULL) ? font->rangeCount : 0;
+
+  for(uint32_t i=0; i < glyphCount; i++)
+  {
+    uint32_t end = font->glyph[i].bitmapOffset + ((((uint32_t)font->glyph[i].width * font->glyph[i].height) + 7) / 8);
+    if(end > hdr.bitmapSize)
+      hdr.bitmapSize = end;
+  }
+
+  //lay out the tables
+  offset = sizeof(mono_gfx_font_file_header_t);
+  hdr.glyphOffset = offset;
+  offset += glyphCount * sizeof(GFXglyph);
+  hdr.rangeOffset = offset;
+  offset += hdr.rangeCount * sizeof(GFXrange);
+
+  if(font->kern != NULL)
+  {
+    //the file index always covers every glyph, pad out the end if the font's table is shorter
+    hdr.kernPairCount = font->kern->index[font->kern->glyphCount];
+    hdr.kernIndexOffset = offset;
+    offset += (glyphCount + 1) * sizeof(uint16_t);
+    offset = (offset + 3) & ~3u;
+    hdr.kernPairOffset = offset;
+    offset += hdr.kernPairCount * sizeof(GFXkernPair);
+  }
+
+  offset = (offset + 3) & ~3u;
+  hdr.bitmapOffset = offset;
+
+  fp = fopen(path, "wb");
+  if(fp == NULL)
+    return MRT_STATUS_ERROR;
+
+  offset = fwrite(&hdr, 1, sizeof(hdr), fp);
+  offset += fwrite(font->glyph, 1, glyphCount * sizeof(GFXglyph), fp);
+  if(hdr.rangeCount > 0)
+    offset += fwrite(font->ranges, 1, hdr.rangeCount * sizeof(GFXrange), fp);
+
+  if(font->kern != NULL)
+  {
+    for(uint32_t i=0; i <= glyphCount; i++)
+    {
+      uint16_t idx = (i <= font->kern->glyphCount) ? font->kern->index[i] : hdr.kernPairCount;
+      offset += fwrite(&idx, 1, sizeof(idx), fp);
+    }
+    offset = _align(fp, offset);
+    offset += fwrite(font->kern->pairs, 1, hdr.kernPairCount * sizeof(GFXkernPair), fp);
+  }
+
+  offset = _align(fp, offset);
+  offset += fwrite(font->bitmap, 1, hdr.bitmapSize, fp);
+
+  if((fclose(fp) != 0) || (offset != hdr.bitmapOffset + hdr.bitmapSize))
+    return MRT_STATUS_ERROR;
+
+  return MRT_STATUS_OK;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,99 @@
+/**
+  *@file mono_gfx_font_file.h
+  *@brief loads GFXfonts from memory mapped binary font files
+  *@author Jason Berger
+  *@date 10/18/2026
+  *
+  * File layout (all values in native byte order, tables stored as the in memory structs so they can be used in place):
+  *
+  *   mono_gfx_font_file_header_t
+  *   GFXglyph    glyphs[glyphCount]
+  *   GFXrange    ranges[rangeCount]
+  *   uint16_t    kernIndex[glyphCount + 1]   (only if kernPairCount > 0)
+  *   GFXkernPair kernPairs[kernPairCount]
+  *   uint8_t     bitmap[bitmapSize]
+  *
+  * Each table starts at the offset given in the header, aligned to 4 bytes.
+  */
+#pragma once
+
+#include "mono_gfx.h"
+#include "mono_gfx_font_pager.h"
+
+#define MONO_GFX_FONT_FILE_MAGIC "MGFX"
+#define MONO_GFX_FONT_FILE_VERSION 1
+#define MONO_GFX_FONT_FILE_BYTE_ORDER 0x01020304
+
+typedef struct{
+	char     magic[4];          //MONO_GFX_FONT_FILE_MAGIC
+	uint16_t version;           //MONO_GFX_FONT_FILE_VERSION
+	uint16_t headerSize;        //sizeof(mono_gfx_font_file_header_t)
+	uint32_t byteOrder;         //MONO_GFX_FONT_FILE_BYTE_ORDER as written by the host that made the file
+	uint8_t  glyphSize;         //sizeof(GFXglyph)
+	uint8_t  rangeSize;         //sizeof(GFXrange)
+	uint8_t  kernPairSize;      //sizeof(GFXkernPair)
+	uint8_t  first, last;       //primary block extents
+	uint8_t  yAdvance;          //Newline distance (y axis)
+	uint16_t reserved;
+	uint32_t glyphCount;
+	uint32_t rangeCount;
+	uint32_t kernPairCount;
+	uint32_t glyphOffset;       //file offsets of each table
+	uint32_t rangeOffset;
+	uint32_t kernIndexOffset;
+	uint32_t kernPairOffset;
+	uint32_t bitmapOffset;
+	uint32_t bitmapSize;
+}mono_gfx_font_file_header_t;
+
+typedef struct{
+	GFXfont mFont;              //font pointing into the mapped file, use &file.mFont as gfx->mFont
+	GFXkern mKern;              //kerning table pointing into the mapped file
+	GFXfontCache mCache;        //lookups kept with the font
+	void* mMap;                 //base of mapping (or of the tables read into memory for a paged file)
+	size_t mSize;               //size of file
+	mono_gfx_font_pager_t* mPager; //pager the bitmap is read through, NULL if the whole file is mapped
+	int mFd;                    //descriptor kept open for the pager (only used when mPager is set)
+}mono_gfx_font_file_t;
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+  *@brief maps a binary font file and validates it. Glyph and bitmap tables are used in place, so only the pages that get drawn from are read in
+  *@param file ptr to font file object
+  *@param path path of file
+  *@return MRT_STATUS_ERROR if the file can not be mapped or fails validation
+  */
+mrt_status_t mono_gfx_font_file_open(mono_gfx_font_file_t* file, const char* path);
+
+/**
+  *@brief opens a binary font file without mapping it. The glyph, range, and kerning tables are read into memory, and bitmaps are read
+  *       in pages through a pager as they are drawn. This stands in for fonts kept in external flash
+  *@param file ptr to font file object
+  *@param path path of file
+  *@param pager ptr to pager to use for the bitmap, must stay valid while the font is open
+  *@return MRT_STATUS_ERROR if the file can not be read or fails validation
+  */
+mrt_status_t mono_gfx_font_file_open_paged(mono_gfx_font_file_t* file, const char* path, mono_gfx_font_pager_t* pager);
+
+/**
+  *@brief unmaps or closes a font file. The font must not be used after this, and canvases that drew with it must be flushed with mono_gfx_flush_glyph_cache first
+  *@param file ptr to font file object
+  *@return status
+  */
+mrt_status_t mono_gfx_font_file_close(mono_gfx_font_file_t* file);
+
+/**
+  *@brief writes a font to a binary font file
+  *@param font ptr to font
+  *@param path path of file to create
+  *@return status
+  */
+mrt_status_t mono_gfx_font_file_write(const GFXfont* font, const char* path);
+
+#ifdef __cplusplus
+}
+#endif
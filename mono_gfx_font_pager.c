@@ -0,0 +1,117 @@
+/**
+  *@file mono_gfx_font_pager.c
+  *@brief reads glyph bitmaps in pages from storage that is not memory mapped (SPI flash, files, etc)
+  *@author Jason Berger
+  *@date 10/18/2026
+  */
+
+#include "mono_gfx_font_pager.h"
+#include "string.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+mrt_status_t mono_gfx_font_pager_init(mono_gfx_font_pager_t* pager, f_mono_gfx_font_read read_cb, void* ctx, uint32_t base, uint32_t size)
+{
+  memset(pager, 0, sizeof(mono_gfx_font_pager_t));
+  pager->fRead = read_cb;
+  pager->mCtx = ctx;
+  pager->mBase = base;
+  pager->mSize = size;
+
+  return MRT_STATUS_OK;
+}
+
+void mono_gfx_font_pager_flush(mono_gfx_font_pager_t* pager)
+{
+  for(int i=0; i < MONO_GFX_FONT_PAGE_COUNT; i++)
+    pager->mPages[i].mUsed = 0;
+}
+
+/**
+  *@brief finds a page in the cache, reading it over the least recently used one on a miss
+  *@return ptr to page, or NULL if the read failed
+  */
+static mono_gfx_font_page_t* _page(mono_gfx_font_pager_t* pager, uint32_t num)
+{
+  mono_gfx_font_page_t* victim = &pager->mPages[0];
+
+  for(int i=0; i < MONO_GFX_FONT_PAGE_COUNT; i++)
+  {
+    mono_gfx_font_page_t* page = &pager->mPages[i];
+
+    if((page->mUsed != 0) && (page->mPage == num))
+    {
+      pager->mHits++;
+      page->mUsed = ++pager->mTick;
+      return page;
+    }
+
+    if(page->mUsed < victim->mUsed)
+      victim = page;
+  }
+
+  pager->mMisses++;
+
+  uint32_t start = num * MONO_GFX_FONT_PAGE_SIZE;
+  uint32_t len = pager->mSize - start;
+  if(len > MONO_GFX_FONT_PAGE_SIZE)
+    len = MONO_GFX_FONT_PAGE_SIZE;
+
+  if(pager->fRead(pager->mCtx, pager->mBase + start, victim->mData, len) != MRT_STATUS_OK)
+  {
+    victim->mUsed = 0;
+    return NULL;
+  }
+
+  victim->mPage = num;
+  victim->mUsed = ++pager->mTick;
+  return victim;
+}
+
+const uint8_t* mono_gfx_font_pager_get(mono_gfx_font_pager_t* pager, uint32_t offset, uint32_t len)
+{
+  mono_gfx_font_page_t* page;
+  uint32_t first = offset / MONO_GFX_FONT_PAGE_SIZE;
+
+  //empty glyphs like space have nothing to read
+  if(len == 0)
+    return pager->mScratch;
+
+  if((offset >= pager->mSize) || (len > pager->mSize - offset))
+    return NULL;
+
+  //most glyphs sit inside of one page and can be used straight from the cache
+  if((offset + len - 1) / MONO_GFX_FONT_PAGE_SIZE == first)
+  {
+    page = _page(pager, first);
+    return (page != NULL) ? &page->mData[offset % MONO_GFX_FONT_PAGE_SIZE] : NULL;
+  }
+
+  if(len > MONO_GFX_FONT_PAGER_GLYPH_BYTES)
+    return NULL;
+
+  //copy the pieces from each page it crosses
+  for(uint32_t done = 0; done < len; )
+  {
+    uint32_t at = offset + done;
+    uint32_t n = MONO_GFX_FONT_PAGE_SIZE - (at % MONO_GFX_FONT_PAGE_SIZE);
+    if(n > len - done)
+      n = len - done;
+
+    page = _page(pager, at / MONO_GFX_FONT_PAGE_SIZE);
+    if(page == NULL)
+      return NULL;
+
+    memcpy(&pager->mScratch[done], &page->mData[at % MONO_GFX_FONT_PAGE_SIZE], n);
+    done += n;
+  }
+
+  return pager->mScratch;
+}
+
+#ifdef __cplusplus
+}
+#endif
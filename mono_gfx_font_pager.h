@@ -0,0 +1,84 @@
+/**
+  *@file mono_gfx_font_pager.h
+  *@brief reads glyph bitmaps in pages from storage that is not memory mapped (SPI flash, files, etc)
+  *@author Jason Berger
+  *@date 10/18/2026
+  */
+#pragma once
+
+#include "mono_gfx.h"
+
+#ifndef MONO_GFX_FONT_PAGE_SIZE
+#define MONO_GFX_FONT_PAGE_SIZE 256       //bytes read from storage at a time
+#endif
+
+#ifndef MONO_GFX_FONT_PAGE_COUNT
+#define MONO_GFX_FONT_PAGE_COUNT 8        //pages held in the cache
+#endif
+
+#ifndef MONO_GFX_FONT_PAGER_GLYPH_BYTES
+#define MONO_GFX_FONT_PAGER_GLYPH_BYTES 512   //largest glyph bitmap that can cross a page boundary
+#endif
+
+/**
+  *@brief reads bytes from font storage
+  *@param ctx context pointer given to mono_gfx_font_pager_init
+  *@param offset offset in storage to read from
+  *@param data ptr to store data
+  *@param len number of bytes to read
+  *@return MRT_STATUS_ERROR if the read failed
+  */
+typedef mrt_status_t (*f_mono_gfx_font_read)(void* ctx, uint32_t offset, uint8_t* data, uint32_t len);
+
+typedef struct{
+	uint32_t mPage;               //page number held (offset / MONO_GFX_FONT_PAGE_SIZE)
+	uint32_t mUsed;               //tick of last use, 0 if the page is empty
+	uint8_t mData[MONO_GFX_FONT_PAGE_SIZE];
+}mono_gfx_font_page_t;
+
+typedef struct mono_gfx_font_pager_struct{
+	f_mono_gfx_font_read fRead;   //read callback
+	void* mCtx;                   //passed to fRead
+	uint32_t mBase;               //offset of the bitmap table in storage
+	uint32_t mSize;               //size of the bitmap table
+	mono_gfx_font_page_t mPages[MONO_GFX_FONT_PAGE_COUNT];
+	uint32_t mTick;               //use counter for picking the least recently used page
+	uint8_t mScratch[MONO_GFX_FONT_PAGER_GLYPH_BYTES];  //glyphs that cross a page boundary are put back together here
+	uint32_t mHits;               //statistics, counted per page looked up
+	uint32_t mMisses;
+}mono_gfx_font_pager_t;
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+  *@brief initializes a pager. Point a font at it by setting font->pager, the font's bitmap pointer is then unused
+  *@param pager ptr to pager
+  *@param read_cb callback to read from storage
+  *@param ctx context pointer passed to read_cb
+  *@param base offset of the bitmap table in storage (glyph bitmapOffsets are relative to this)
+  *@param size size of the bitmap table
+  *@return status
+  */
+mrt_status_t mono_gfx_font_pager_init(mono_gfx_font_pager_t* pager, f_mono_gfx_font_read read_cb, void* ctx, uint32_t base, uint32_t size);
+
+/**
+  *@brief gets bytes from the bitmap table, reading pages in as needed
+  *@param pager ptr to pager
+  *@param offset offset in the bitmap table
+  *@param len number of bytes
+  *@return ptr to the bytes, valid until the next call. NULL if they could not be read
+  */
+const uint8_t* mono_gfx_font_pager_get(mono_gfx_font_pager_t* pager, uint32_t offset, uint32_t len);
+
+/**
+  *@brief drops every cached page
+  *@param pager ptr to pager
+  */
+void mono_gfx_font_pager_flush(mono_gfx_font_pager_t* pager);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,271 @@
+/**
+  *@file mono_gfx_term.c
+  *@brief character cell terminal drawn with a fixed advance font
+  *@author Jason Berger
+  *@date 10/18/2026
+  */
+
+#include "mono_gfx_term.h"
+#include "string.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+//adds a span of rows to the dirty area
+static void _mark_rows(mono_gfx_term_t* term, int y0, int y1)
+{
+  if(term->mDirtyRect.h == 0)
+  {
+    term->mDirtyRect.y = y0;
+    term->mDirtyRect.h = y1 - y0;
+  }
+  else
+  {
+    int bottom = term->mDirtyRect.y + term->mDirtyRect.h;
+    if(y0 < term->mDirtyRect.y)
+      term->mDirtyRect.y = y0;
+    if(y1 > bottom)
+      bottom = y1;
+    term->mDirtyRect.h = bottom - term->mDirtyRect.y;
+  }
+  term->mDirtyRect.x = term->mRect.x;
+  term->mDirtyRect.w = term->mRect.w;
+}
+
+//grows the ascent of the terminal to fit a glyph
+static void _fit_glyph(mono_gfx_term_t* term, const GFXglyph* glyph)
+{
+  if(-glyph->yOffset > term->mAscent)
+    term->mAscent = -glyph->yOffset;
+}
+
+mrt_status_t mono_gfx_term_init(mono_gfx_term_t* term, mono_gfx_t* gfx, const GFXfont* font, int x, int y, int w, int h)
+{
+  memset(term, 0, sizeof(mono_gfx_term_t));
+
+  term->mCellW = mono_gfx_fixed_advance(font);
+  term->mCellH = font->yAdvance;
+  if((term->mCellW == 0) || (term->mCellH == 0))
+    return MRT_STATUS_ERROR;
+
+  term->mCols = w / term->mCellW;
+  term->mRows = h / term->mCellH;
+  if(term->mCols > MONO_GFX_TERM_MAX_COLS)
+    term->mCols = MONO_GFX_TERM_MAX_COLS;
+  if(term->mRows > MONO_GFX_TERM_MAX_ROWS)
+    term->mRows = MONO_GFX_TERM_MAX_ROWS;
+  if((term->mCols == 0) || (term->mRows == 0))
+    return MRT_STATUS_ERROR;
+
+  //baseline sits low enough in the cell for the tallest glyph
+  for(int i=0; i <= font->last - font->first; i++)
+    _fit_glyph(term, &font->glyph[i]);
+
+  for(int r=0; r < font->rangeCount; r++)
+  {
+    for(uint32_t i=0; i <= font->ranges[r].last - font->ranges[r].first; i++)
+      _fit_glyph(term, &font->glyph[font->ranges[r].glyphIndex + i]);
+  }
+
+  term->mGfx = gfx;
+  term->mFont = font;
+  term->mRect.x = x;
+  term->mRect.y = y;
+  term->mRect.w = term->mCols * term->mCellW;
+  term->mRect.h = term->mRows * term->mCellH;
+  term->mFg = MONO_GFX_PIXEL_ON;
+  term->mBg = MONO_GFX_PIXEL_OFF;
+
+  const uint8_t* pattern = gfx->mPattern;
+  gfx->mPattern = NULL;
+  mono_gfx_draw_rect(gfx, term->mRect.x, term->mRect.y, term->mRect.w, term->mRect.h, term->mBg);
+  gfx->mPattern = pattern;
+  _mark_rows(term, term->mRect.y, term->mRect.y + term->mRect.h);
+
+  return MRT_STATUS_OK;
+}
+
+//moves the cursor to the start of the next line, scrolling the grid up if it is on the last one
+static void _newline(mono_gfx_term_t* term)
+{
+  term->mCol = 0;
+
+  if(term->mRow < term->mRows - 1)
+  {
+    term->mRow++;
+    return;
+  }
+
+  //the pixels are moved to match when the terminal is rendered
+  int last = term->mRows - 1;
+  memmove(term->mCells[0], term->mCells[1], sizeof(term->mCells[0]) * last);
+  memmove(term->mDirty[0], term->mDirty[1], sizeof(term->mDirty[0]) * last);
+  memmove(term->mRowDirty, &term->mRowDirty[1], sizeof(term->mRowDirty[0]) * last);
+  memset(term->mCells[last], 0, sizeof(term->mCells[last]));
+  memset(term->mDirty[last], 0, sizeof(term->mDirty[last]));
+  term->mRowDirty[last] = false;
+
+  if(term->mScroll < term->mRows)
+    term->mScroll++;
+}
+
+void mono_gfx_term_putc(mono_gfx_term_t* term, uint32_t c)
+{
+  if(c == '\n')
+  {
+    _newline(term);
+    return;
+  }
+
+  if(c == '\r')
+  {
+    term->mCol = 0;
+    return;
+  }
+
+  if(term->mCol >= term->mCols)
+    _newline(term);
+
+  //characters missing from the font still take up a cell, so the columns stay aligned
+  const GFXglyph* glyph = mono_gfx_get_glyph(term->mFont, c);
+  uint16_t cell = (glyph != NULL) ? (glyph - term->mFont->glyph) + 1 : 0;
+
+  if(term->mCells[term->mRow][term->mCol] != cell)
+  {
+    term->mCells[term->mRow][term->mCol] = cell;
+    term->mDirty[term->mRow][term->mCol] = true;
+    term->mRowDirty[term->mRow] = true;
+  }
+
+  term->mCol++;
+}
+
+void mono_gfx_term_write(mono_gfx_term_t* term, const char* text)
+{
+  uint32_t c;
+
+  while((c = mono_gfx_utf8_next(&text)) != 0)
+  {
+    mono_gfx_term_putc(term, c);
+  }
+}
+
+void mono_gfx_term_clear(mono_gfx_term_t* term)
+{
+  for(int r=0; r < term->mRows; r++)
+  {
+    for(int c=0; c < term->mCols; c++)
+    {
+      if(term->mCells[r][c] != 0)
+      {
+        term->mCells[r][c] = 0;
+        term->mDirty[r][c] = true;
+        term->mRowDirty[r] = true;
+      }
+    }
+  }
+
+  term->mCol = 0;
+  term->mRow = 0;
+}
+
+int mono_gfx_term_render(mono_gfx_term_t* term)
+{
+  mono_gfx_t* gfx = term->mGfx;
+  const uint8_t* pattern = gfx->mPattern;
+  int drawn = 0;
+
+  //cells are cleared solid, whatever brush the canvas is set up with
+  gfx->mPattern = NULL;
+
+  if(term->mScroll > 0)
+  {
+    if(mono_gfx_scroll(gfx, term->mRect.x, term->mRect.y, term->mRect.w, term->mRect.h, term->mScroll * term->mCellH, term->mBg) != MRT_STATUS_OK)
+    {
+      //the canvas can not be read back, so redraw everything that is not blank
+      mono_gfx_draw_rect(gfx, term->mRect.x, term->mRect.y, term->mRect.w, term->mRect.h, term->mBg);
+      for(int r=0; r < term->mRows; r++)
+      {
+        for(int c=0; c < term->mCols; c++)
+        {
+          if(term->mCells[r][c] != 0)
+          {
+            term->mDirty[r][c] = true;
+            term->mRowDirty[r] = true;
+          }
+        }
+      }
+    }
+
+    _mark_rows(term, term->mRect.y, term->mRect.y + term->mRect.h);
+    term->mScroll = 0;
+  }
+
+  //cells are drawn upright and unscaled no matter how the canvas is set up for print
+  uint8_t scale = gfx->mTextScale;
+  uint8_t style = gfx->mTextStyle;
+  uint8_t rotation = gfx->mTextRotation;
+  gfx->mTextScale = 1;
+  gfx->mTextStyle = MONO_GFX_STYLE_NORMAL;
+  gfx->mTextRotation = MONO_GFX_ROTATE_0;
+
+  for(int r=0; r < term->mRows; r++)
+  {
+    if(!term->mRowDirty[r])
+      continue;
+
+    int top = term->mRect.y + (r * term->mCellH);
+    int c = 0;
+
+    while(c < term->mCols)
+    {
+      if(!term->mDirty[r][c])
+      {
+        c++;
+        continue;
+      }
+
+      //clear each run of dirty cells with one rect, then draw their glyphs
+      int start = c;
+      while((c < term->mCols) && term->mDirty[r][c])
+        c++;
+
+      mono_gfx_draw_rect(gfx, term->mRect.x + (start * term->mCellW), top, (c - start) * term->mCellW, term->mCellH, term->mBg);
+
+      for(int i = start; i < c; i++)
+      {
+        if(term->mCells[r][i] != 0)
+          mono_gfx_draw_glyph(gfx, term->mFont, &term->mFont->glyph[term->mCells[r][i] - 1], term->mRect.x + (i * term->mCellW), top + term->mAscent, term->mFg);
+
+        term->mDirty[r][i] = false;
+      }
+      drawn += c - start;
+    }
+
+    term->mRowDirty[r] = false;
+    _mark_rows(term, top, top + term->mCellH);
+  }
+
+  gfx->mTextScale = scale;
+  gfx->mTextStyle = style;
+  gfx->mTextRotation = rotation;
+  gfx->mPattern = pattern;
+
+  return drawn;
+}
+
+bool mono_gfx_term_get_dirty(mono_gfx_term_t* term, GFXrect* rect)
+{
+  if(term->mDirtyRect.h == 0)
+    return false;
+
+  *rect = term->mDirtyRect;
+  memset(&term->mDirtyRect, 0, sizeof(GFXrect));
+  return true;
+}
+
+#ifdef __cplusplus
+}
+#endif
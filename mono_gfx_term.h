@@ -0,0 +1,94 @@
+/**
+  *@file mono_gfx_term.h
+  *@brief character cell terminal drawn with a fixed advance font
+  *@author Jason Berger
+  *@date 10/18/2026
+  */
+#pragma once
+
+#include "mono_gfx.h"
+
+#ifndef MONO_GFX_TERM_MAX_COLS
+#define MONO_GFX_TERM_MAX_COLS 48
+#endif
+
+#ifndef MONO_GFX_TERM_MAX_ROWS
+#define MONO_GFX_TERM_MAX_ROWS 8
+#endif
+
+typedef struct{
+	mono_gfx_t* mGfx;             //canvas the terminal draws on
+	const GFXfont* mFont;         //fixed advance font
+	GFXrect mRect;                //area of the canvas covered by the grid
+	int mCellW;                   //size of a cell in pixels
+	int mCellH;
+	int mAscent;                  //distance from the top of a cell to the baseline
+	int mCols;                    //size of the grid in cells
+	int mRows;
+	int mCol;                     //cursor position
+	int mRow;
+	uint8_t mFg;                  //pixel value for text
+	uint8_t mBg;                  //pixel value for background
+	uint16_t mCells[MONO_GFX_TERM_MAX_ROWS][MONO_GFX_TERM_MAX_COLS];  //glyph index + 1 in each cell (0 for blank)
+	bool mDirty[MONO_GFX_TERM_MAX_ROWS][MONO_GFX_TERM_MAX_COLS];      //cell has changed since it was last drawn
+	bool mRowDirty[MONO_GFX_TERM_MAX_ROWS];                           //row has at least one dirty cell
+	int mScroll;                  //rows scrolled since the last render
+	GFXrect mDirtyRect;           //area changed since the last call to mono_gfx_term_get_dirty
+}mono_gfx_term_t;
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+  *@brief initializes a terminal over an area of the canvas. The grid is as many cells as fit in the area
+  *@param term ptr to terminal
+  *@param gfx ptr to canvas
+  *@param font font to use, must have a fixed advance
+  *@param x x coord of terminal
+  *@param y y coord of terminal
+  *@param w width of terminal
+  *@param h height of terminal
+  *@return MRT_STATUS_ERROR if the font is proportional or the area is smaller than one cell
+  */
+mrt_status_t mono_gfx_term_init(mono_gfx_term_t* term, mono_gfx_t* gfx, const GFXfont* font, int x, int y, int w, int h);
+
+/**
+  *@brief writes a character at the cursor. '\n' moves to the start of the next line, '\r' to the start of the current one. The grid scrolls when the cursor passes the last row
+  *@param term ptr to terminal
+  *@param c unicode codepoint
+  */
+void mono_gfx_term_putc(mono_gfx_term_t* term, uint32_t c);
+
+/**
+  *@brief writes a string at the cursor
+  *@param term ptr to terminal
+  *@param text text to write (UTF-8)
+  */
+void mono_gfx_term_write(mono_gfx_term_t* term, const char* text);
+
+/**
+  *@brief blanks every cell and moves the cursor home
+  *@param term ptr to terminal
+  */
+void mono_gfx_term_clear(mono_gfx_term_t* term);
+
+/**
+  *@brief applies pending scrolling and draws the cells that changed since the last render. Writes only update the grid, so this can be called at the display frame rate no matter how fast text arrives
+  *@param term ptr to terminal
+  *@return number of cells drawn
+  */
+int mono_gfx_term_render(mono_gfx_term_t* term);
+
+/**
+  *@brief gets the area that has changed since the last call and clears it
+  *@param term ptr to terminal
+  *@param rect ptr to store dirty area
+  *@return true if anything changed
+  */
+bool mono_gfx_term_get_dirty(mono_gfx_term_t* term, GFXrect* rect);
+
+#ifdef __cplusplus
+}
+#endif
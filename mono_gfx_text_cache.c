@@ -0,0 +1,225 @@
+/**
+  *@file mono_gfx_text_cache.c
+  *@brief cache of rendered strings so repeated text is only rasterised once
+  *@author Jason Berger
+  *@date 10/18/2026
+  */
+
+#include "mono_gfx_text_cache.h"
+#include "string.h"
+#include <stdlib.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+//FNV-1a over the string, mixed with the settings that change how it renders
+static uint32_t _hash(const GFXfont* font, const GFXfontChain* chain, uint8_t scale, uint8_t style, const char* text, uint32_t* len)
+{
+  uint32_t hash = 2166136261u;
+  const char* c = text;
+
+  while(*c)
+  {
+    hash = (hash ^ (uint8_t)*c++) * 16777619u;
+  }
+  *len = c - text;
+
+  hash = (hash ^ (uint32_t)(uintptr_t)font) * 16777619u;
+  hash = (hash ^ (uint32_t)(uintptr_t)chain) * 16777619u;
+  hash = (hash ^ ((uint32_t)scale << 8 | style)) * 16777619u;
+  return hash;
+}
+
+//unlinks an entry from its bucket and marks it empty
+static void _evict(mono_gfx_text_cache_t* cache, int idx)
+{
+  mono_gfx_text_cache_entry_t* entry = &cache->mEntries[idx];
+  int16_t* link = &cache->mBuckets[entry->mHash % cache->mBucketCount];
+
+  while(*link != idx)
+    link = &cache->mEntries[*link].mNext;
+  *link = entry->mNext;
+
+  entry->mSeq = 0;
+  cache->mEvictions++;
+}
+
+mrt_status_t mono_gfx_text_cache_init(mono_gfx_text_cache_t* cache, uint32_t budget, int maxEntries)
+{
+  memset(cache, 0, sizeof(mono_gfx_text_cache_t));
+
+  cache->mArena = (uint8_t*) malloc(budget);
+  cache->mEntries = (mono_gfx_text_cache_entry_t*) malloc(maxEntries * sizeof(mono_gfx_text_cache_entry_t));
+  cache->mBuckets = (int16_t*) malloc(maxEntries * sizeof(int16_t));
+
+  if((cache->mArena == NULL) || (cache->mEntries == NULL) || (cache->mBuckets == NULL) || (maxEntries <= 0) || (maxEntries > 0x7FFF))
+  {
+    mono_gfx_text_cache_deinit(cache);
+    return MRT_STATUS_ERROR;
+  }
+
+  cache->mArenaSize = budget;
+  cache->mEntryCount = maxEntries;
+  cache->mBucketCount = maxEntries;
+  mono_gfx_text_cache_clear(cache);
+
+  return MRT_STATUS_OK;
+}
+
+mrt_status_t mono_gfx_text_cache_deinit(mono_gfx_text_cache_t* cache)
+{
+  free(cache->mArena);
+  free(cache->mEntries);
+  free(cache->mBuckets);
+  memset(cache, 0, sizeof(mono_gfx_text_cache_t));
+
+  return MRT_STATUS_OK;
+}
+
+void mono_gfx_text_cache_clear(mono_gfx_text_cache_t* cache)
+{
+  for(int i=0; i < cache->mEntryCount; i++)
+    cache->mEntries[i].mSeq = 0;
+
+  for(int i=0; i < cache->mBucketCount; i++)
+    cache->mBuckets[i] = -1;
+
+  cache->mHead = 0;
+}
+
+/**
+  *@brief reserves space in the arena, evicting whatever is in the way
+  *@return index of entry to fill, or -1 if the string is too big for the cache
+  */
+static int _alloc(mono_gfx_text_cache_t* cache, uint32_t size)
+{
+  int slot = -1;
+  int oldest = -1;
+
+  if(size > cache->mArenaSize)
+    return -1;
+
+  //wrap to the start rather than split an entry
+  if(cache->mHead + size > cache->mArenaSize)
+    cache->mHead = 0;
+
+  for(int i=0; i < cache->mEntryCount; i++)
+  {
+    mono_gfx_text_cache_entry_t* entry = &cache->mEntries[i];
+
+    if(entry->mSeq == 0)
+    {
+      slot = i;
+      continue;
+    }
+
+    //anything overlapping the new space is older than everything after it, so it goes
+    if((entry->mOffset < cache->mHead + size) && (entry->mOffset + entry->mSize > cache->mHead))
+    {
+      _evict(cache, i);
+      slot = i;
+      continue;
+    }
+
+    if((oldest < 0) || (entry->mSeq < cache->mEntries[oldest].mSeq))
+      oldest = i;
+  }
+
+  //out of entries, drop the oldest one
+  if(slot < 0)
+  {
+    _evict(cache, oldest);
+    slot = oldest;
+  }
+
+  cache->mEntries[slot].mOffset = cache->mHead;
+  cache->mEntries[slot].mSize = size;
+  cache->mHead += size;
+
+  return slot;
+}
+
+mrt_status_t mono_gfx_text_cache_print(mono_gfx_text_cache_t* cache, mono_gfx_t* gfx, int x, int y, const char* text, uint8_t val)
+{
+  uint32_t len;
+  uint32_t hash;
+  int idx;
+  mono_gfx_text_cache_entry_t* entry;
+  GFXBmp bmp;
+
+  if((gfx->mFont == NULL) || (gfx->mTextRotation != MONO_GFX_ROTATE_0))
+    return MRT_STATUS_ERROR;
+
+  hash = _hash(gfx->mFont, gfx->mFontChain, gfx->mTextScale, gfx->mTextStyle, text, &len);
+
+  for(idx = cache->mBuckets[hash % cache->mBucketCount]; idx >= 0; idx = entry->mNext)
+  {
+    entry = &cache->mEntries[idx];
+    if( (entry->mHash == hash) && (entry->mFont == gfx->mFont) && (entry->mChain == gfx->mFontChain) && (entry->mScale == gfx->mTextScale) &&
+        (entry->mStyle == gfx->mTextStyle) && (entry->mTextLen == len) &&
+        (memcmp(&cache->mArena[entry->mOffset + entry->mSize - len], text, len) == 0) )
+      break;
+  }
+
+  if(idx >= 0)
+  {
+    cache->mHits++;
+  }
+  else
+  {
+    //render the string into the arena as a bitmap just big enough for its ink
+    GFXrect bounds;
+    mono_gfx_t canvas;
+
+    cache->mMisses++;
+    mono_gfx_text_bounds(gfx, text, &bounds);
+
+    uint32_t bmpSize = (((uint32_t)bounds.w * bounds.h) + 7) / 8;
+    idx = _alloc(cache, bmpSize + len);
+    if(idx < 0)
+      return MRT_STATUS_ERROR;
+
+    entry = &cache->mEntries[idx];
+    entry->mFont = gfx->mFont;
+    entry->mChain = gfx->mFontChain;
+    entry->mScale = gfx->mTextScale;
+    entry->mStyle = gfx->mTextStyle;
+    entry->mTextLen = len;
+    entry->mHash = hash;
+    entry->mBounds = bounds;
+    entry->mSeq = ++cache->mSeq;
+    memcpy(&cache->mArena[entry->mOffset + bmpSize], text, len);
+
+    //canvas over the arena, with no cache attached so print draws directly
+    memset(&canvas, 0, sizeof(canvas));
+    canvas.mBuffer = &cache->mArena[entry->mOffset];
+    canvas.mWidth = bounds.w;
+    canvas.mHeight = bounds.h;
+    canvas.mBufferSize = bmpSize;
+    canvas.mFont = gfx->mFont;
+    canvas.mFontChain = gfx->mFontChain;
+    canvas.mTextScale = gfx->mTextScale;
+    canvas.mTextStyle = gfx->mTextStyle;
+    canvas.mTextRotation = MONO_GFX_ROTATE_0;
+    canvas.fWritePixel = &mono_gfx_write_pixel;
+    canvas.mBuffered = true;
+    memset(canvas.mBuffer, 0, bmpSize);
+    mono_gfx_print(&canvas, -bounds.x, -bounds.y, text, MONO_GFX_PIXEL_ON);
+
+    int16_t* bucket = &cache->mBuckets[hash % cache->mBucketCount];
+    entry->mNext = *bucket;
+    *bucket = idx;
+  }
+
+  bmp.data = &cache->mArena[entry->mOffset];
+  bmp.width = entry->mBounds.w;
+  bmp.height = entry->mBounds.h;
+
+  return mono_gfx_draw_bmp(gfx, x + entry->mBounds.x, y + entry->mBounds.y, &bmp, val);
+}
+
+#ifdef __cplusplus
+}
+#endif
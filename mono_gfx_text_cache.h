@@ -0,0 +1,80 @@
+/**
+  *@file mono_gfx_text_cache.h
+  *@brief cache of rendered strings so repeated text is only rasterised once
+  *@author Jason Berger
+  *@date 10/18/2026
+  */
+#pragma once
+
+#include "mono_gfx.h"
+
+typedef struct{
+	const GFXfont* mFont;         //font, fallback chain, scale, and style the string was rendered with
+	const GFXfontChain* mChain;
+	uint8_t mScale;
+	uint8_t mStyle;
+	uint32_t mTextLen;            //length of string in bytes
+	uint32_t mHash;               //hash of string and render settings
+	GFXrect mBounds;              //ink box of the string relative to the print origin
+	uint32_t mOffset;             //offset of bitmap in arena, the string itself is stored right after it
+	uint32_t mSize;               //bytes of arena used by bitmap and string
+	uint32_t mSeq;                //order entries were added in, 0 if the entry is empty
+	int16_t mNext;                //next entry in the same bucket (-1 for none)
+}mono_gfx_text_cache_entry_t;
+
+typedef struct mono_gfx_text_cache_struct{
+	uint8_t* mArena;              //memory for rendered strings
+	uint32_t mArenaSize;          //memory budget in bytes
+	uint32_t mHead;               //next free byte of the arena, allocations wrap around and evict the oldest entries
+	mono_gfx_text_cache_entry_t* mEntries;
+	int mEntryCount;
+	int16_t* mBuckets;            //first entry for each hash bucket (-1 for none)
+	int mBucketCount;
+	uint32_t mSeq;                //last sequence number handed out
+	uint32_t mHits;               //statistics
+	uint32_t mMisses;
+	uint32_t mEvictions;
+}mono_gfx_text_cache_t;
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+  *@brief initializes a text cache and allocates its memory. Attach it to a canvas by setting gfx->mTextCache
+  *@param cache ptr to cache
+  *@param budget number of bytes to use for rendered strings
+  *@param maxEntries max number of strings to hold at once
+  *@return MRT_STATUS_ERROR if memory could not be allocated
+  */
+mrt_status_t mono_gfx_text_cache_init(mono_gfx_text_cache_t* cache, uint32_t budget, int maxEntries);
+
+/**
+  *@brief frees the memory used by a text cache
+  *@param cache ptr to cache
+  *@return status
+  */
+mrt_status_t mono_gfx_text_cache_deinit(mono_gfx_text_cache_t* cache);
+
+/**
+  *@brief removes all strings from the cache
+  *@param cache ptr to cache
+  */
+void mono_gfx_text_cache_clear(mono_gfx_text_cache_t* cache);
+
+/**
+  *@brief prints text using the cache, rendering and adding it on a miss. Called by mono_gfx_print when a cache is attached
+  *@param cache ptr to cache
+  *@param gfx ptr to canvas to draw on
+  *@param x x coord to begin drawing at
+  *@param y y coord to begin drawing at
+  *@param text text to be written
+  *@param val pixel value
+  *@return MRT_STATUS_ERROR if the text can not be cached (caller should print it directly)
+  */
+mrt_status_t mono_gfx_text_cache_print(mono_gfx_text_cache_t* cache, mono_gfx_t* gfx, int x, int y, const char* text, uint8_t val);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,226 @@
+/**
+  *@file mono_gfx_text_field.c
+  *@brief single line text field that only redraws the characters that change
+  *@author Jason Berger
+  *@date 10/18/2026
+  */
+
+#include "mono_gfx_text_field.h"
+#include "string.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+//adds a span of columns to the dirty area
+static void _mark_dirty(mono_gfx_text_field_t* field, int x0, int x1)
+{
+  if(x0 >= x1)
+    return;
+
+  if(field->mDirty.w == 0)
+  {
+    field->mDirty.x = x0;
+    field->mDirty.w = x1 - x0;
+  }
+  else
+  {
+    int right = field->mDirty.x + field->mDirty.w;
+    if(x0 < field->mDirty.x)
+      field->mDirty.x = x0;
+    if(x1 > right)
+      right = x1;
+    field->mDirty.w = right - field->mDirty.x;
+  }
+  field->mDirty.y = field->mRect.y;
+  field->mDirty.h = field->mRect.h;
+}
+
+//works out the columns a glyph can touch, including its advance and any synthetic style
+static void _cell_extent(mono_gfx_text_cell_t* cell, int scale, uint8_t style)
+{
+  const GFXglyph* glyph = cell->mGlyph;
+  int advance = glyph->xAdvance * scale;
+  int left = cell->mX + ((glyph->xOffset < 0) ? glyph->xOffset * scale : 0);
+  int right = cell->mX + (glyph->xOffset + glyph->width) * scale;
+
+  if(style & MONO_GFX_STYLE_BOLD)
+  {
+    right += scale;
+    advance += scale;
+  }
+
+  if(style & MONO_GFX_STYLE_OBLIQUE)
+  {
+    int lean = ((glyph->height / 4) + 1) * scale;
+    left -= lean;
+    right += lean;
+  }
+
+  if(cell->mX + advance > right)
+    right = cell->mX + advance;
+
+  cell->mLeft = left;
+  cell->mRight = right;
+}
+
+mrt_status_t mono_gfx_text_field_init(mono_gfx_text_field_t* field, mono_gfx_t* gfx, int x, int y, int w, int h, int baseline)
+{
+  memset(field, 0, sizeof(mono_gfx_text_field_t));
+  field->mGfx = gfx;
+  field->mRect.x = x;
+  field->mRect.y = y;
+  field->mRect.w = w;
+  field->mRect.h = h;
+  field->mBaseline = y + baseline;
+  field->mFg = MONO_GFX_PIXEL_ON;
+  field->mBg = MONO_GFX_PIXEL_OFF;
+
+  return MRT_STATUS_OK;
+}
+
+void mono_gfx_text_field_invalidate(mono_gfx_text_field_t* field)
+{
+  //with no font recorded, the next update treats every cell as new and clears the whole field
+  field->mFont = NULL;
+}
+
+mrt_status_t mono_gfx_text_field_update(mono_gfx_text_field_t* field, const char* text)
+{
+  mono_gfx_t* gfx = field->mGfx;
+  mono_gfx_text_cell_t cells[MONO_GFX_TEXT_FIELD_MAX_CHARS];
+  int erased[MONO_GFX_TEXT_FIELD_MAX_CHARS * 2][2];  //column spans that have been cleared
+  int erasedCount = 0;
+  int count = 0;
+  int scale = (gfx->mTextScale > 1) ? gfx->mTextScale : 1;
+  int bold = (gfx->mTextStyle & MONO_GFX_STYLE_BOLD) ? 1 : 0;
+  const GFXglyph* prev = NULL;
+  const GFXfont* prevFont = NULL;
+  const uint8_t* pattern = gfx->mPattern;
+  int x = field->mRect.x;
+  uint32_t c;
+
+  if((gfx->mFont == NULL) || (gfx->mTextRotation != MONO_GFX_ROTATE_0))
+    return MRT_STATUS_ERROR;
+
+  //cells are cleared solid, whatever brush the canvas is set up with
+  gfx->mPattern = NULL;
+
+  //lay out the new text
+  while(((c = mono_gfx_utf8_next(&text)) != 0) && (c != '\n'))
+  {
+    const GFXfont* font = gfx->mFont;
+    const GFXglyph* glyph;
+
+    //characters the canvas font does not have come from its fallbacks, the same as print
+    if(gfx->mFontChain != NULL)
+      glyph = mono_gfx_font_chain_get_glyph(gfx->mFontChain, gfx->mFont, c, &font);
+    else
+      glyph = mono_gfx_get_glyph(gfx->mFont, c);
+
+    if(glyph == NULL)
+      continue;
+
+    //text that does not fit is turned down before anything is drawn, so the field keeps showing what it had
+    if(count == MONO_GFX_TEXT_FIELD_MAX_CHARS)
+    {
+      gfx->mPattern = pattern;
+      return MRT_STATUS_ERROR;
+    }
+
+    mono_gfx_text_cell_t* cell = &cells[count];
+    cell->mCodepoint = c;
+    cell->mGlyph = glyph;
+    cell->mFont = font;
+    cell->mDirty = false;
+
+    //pairs are only kerned within one font
+    if(prevFont == cell->mFont)
+      x += mono_gfx_get_kerning(cell->mFont, prev, cell->mGlyph) * scale;
+    cell->mX = x;
+    _cell_extent(cell, scale, gfx->mTextStyle);
+    x += (cell->mGlyph->xAdvance + bold) * scale;
+    prev = cell->mGlyph;
+    prevFont = cell->mFont;
+    count++;
+  }
+
+  //if the way text is drawn has changed, start from a clean field
+  if((field->mFont != gfx->mFont) || (field->mChain != gfx->mFontChain) || (field->mScale != gfx->mTextScale) || (field->mStyle != gfx->mTextStyle))
+  {
+    mono_gfx_draw_rect(gfx, field->mRect.x, field->mRect.y, field->mRect.w, field->mRect.h, field->mBg);
+    _mark_dirty(field, field->mRect.x, field->mRect.x + field->mRect.w);
+    erased[0][0] = field->mRect.x;
+    erased[0][1] = field->mRect.x + field->mRect.w;
+    erasedCount = 1;
+    field->mCount = 0;
+    field->mFont = gfx->mFont;
+    field->mChain = gfx->mFontChain;
+    field->mScale = gfx->mTextScale;
+    field->mStyle = gfx->mTextStyle;
+  }
+
+  //clear every cell that changed character or moved, both where it was and where it is going
+  int maxCount = (count > field->mCount) ? count : field->mCount;
+  for(int i=0; i < maxCount; i++)
+  {
+    mono_gfx_text_cell_t* oldCell = (i < field->mCount) ? &field->mCells[i] : NULL;
+    mono_gfx_text_cell_t* newCell = (i < count) ? &cells[i] : NULL;
+
+    if((oldCell != NULL) && (newCell != NULL) && (oldCell->mCodepoint == newCell->mCodepoint) && (oldCell->mX == newCell->mX))
+      continue;
+
+    for(int k=0; k < 2; k++)
+    {
+      mono_gfx_text_cell_t* cell = (k == 0) ? oldCell : newCell;
+      if(cell == NULL)
+        continue;
+
+      int x0 = (cell->mLeft > field->mRect.x) ? cell->mLeft : field->mRect.x;
+      int x1 = (cell->mRight < field->mRect.x + field->mRect.w) ? cell->mRight : field->mRect.x + field->mRect.w;
+      if(x0 >= x1)
+        continue;
+
+      mono_gfx_draw_rect(gfx, x0, field->mRect.y, x1 - x0, field->mRect.h, field->mBg);
+      _mark_dirty(field, x0, x1);
+      erased[erasedCount][0] = x0;
+      erased[erasedCount][1] = x1;
+      erasedCount++;
+    }
+  }
+
+  //redraw any glyph that overlaps a cleared span. This includes unchanged neighbours that had pixels wiped by an overlapping cell
+  for(int i=0; i < count; i++)
+  {
+    for(int e=0; e < erasedCount; e++)
+    {
+      if((cells[i].mLeft < erased[e][1]) && (cells[i].mRight > erased[e][0]))
+      {
+        mono_gfx_draw_glyph(gfx, cells[i].mFont, cells[i].mGlyph, cells[i].mX, field->mBaseline, field->mFg);
+        cells[i].mDirty = true;
+        break;
+      }
+    }
+  }
+
+  memcpy(field->mCells, cells, count * sizeof(mono_gfx_text_cell_t));
+  field->mCount = count;
+  gfx->mPattern = pattern;
+
+  return MRT_STATUS_OK;
+}
+
+bool mono_gfx_text_field_get_dirty(mono_gfx_text_field_t* field, GFXrect* rect)
+{
+  if(field->mDirty.w == 0)
+    return false;
+
+  *rect = field->mDirty;
+  memset(&field->mDirty, 0, sizeof(GFXrect));
+  return true;
+}
+
+#ifdef __cplusplus
+}
+#endif
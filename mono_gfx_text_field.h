@@ -0,0 +1,83 @@
+/**
+  *@file mono_gfx_text_field.h
+  *@brief single line text field that only redraws the characters that change
+  *@author Jason Berger
+  *@date 10/18/2026
+  */
+#pragma once
+
+#include "mono_gfx.h"
+
+#ifndef MONO_GFX_TEXT_FIELD_MAX_CHARS
+#define MONO_GFX_TEXT_FIELD_MAX_CHARS 32    //most characters a field can show
+#endif
+
+typedef struct{
+	uint32_t mCodepoint;          //character in this cell
+	const GFXglyph* mGlyph;       //glyph drawn for the character (NULL if the font does not have it)
+	const GFXfont* mFont;         //font the glyph belongs to, the canvas font or one of its fallbacks
+	int mX;                       //pen x of the glyph on the canvas
+	int mLeft;                    //left most column the glyph can touch
+	int mRight;                   //one past the right most column the glyph can touch
+	bool mDirty;                  //redrawn during the last update
+}mono_gfx_text_cell_t;
+
+typedef struct{
+	mono_gfx_t* mGfx;             //canvas the field draws on
+	GFXrect mRect;                //area of the canvas owned by the field
+	int mBaseline;                //y coord of the text baseline on the canvas
+	uint8_t mFg;                  //pixel value for text
+	uint8_t mBg;                  //pixel value for background
+	const GFXfont* mFont;         //font, fallback chain, scale, and style used for the last render
+	const GFXfontChain* mChain;
+	uint8_t mScale;
+	uint8_t mStyle;
+	mono_gfx_text_cell_t mCells[MONO_GFX_TEXT_FIELD_MAX_CHARS];
+	int mCount;                   //number of cells in use
+	GFXrect mDirty;               //area changed since the last call to mono_gfx_text_field_get_dirty
+}mono_gfx_text_field_t;
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+  *@brief initializes a text field over an area of the canvas. Text is drawn with the canvas font, fallback fonts, scale, and style
+  *@param field ptr to text field
+  *@param gfx ptr to canvas
+  *@param x x coord of field
+  *@param y y coord of field
+  *@param w width of field
+  *@param h height of field
+  *@param baseline distance from the top of the field to the text baseline
+  *@return status
+  */
+mrt_status_t mono_gfx_text_field_init(mono_gfx_text_field_t* field, mono_gfx_t* gfx, int x, int y, int w, int h, int baseline);
+
+/**
+  *@brief sets the text of the field. Only cells whose character or position changed are erased and redrawn
+  *@param field ptr to text field
+  *@param text new text (UTF-8, single line). At most MONO_GFX_TEXT_FIELD_MAX_CHARS characters the font can draw
+  *@return MRT_STATUS_ERROR if the canvas has no font, its text is rotated (fields only lay out upright text), or the text has more
+  *        than MONO_GFX_TEXT_FIELD_MAX_CHARS drawable characters. The field is left as it was
+  */
+mrt_status_t mono_gfx_text_field_update(mono_gfx_text_field_t* field, const char* text);
+
+/**
+  *@brief forces every cell to be redrawn on the next update
+  *@param field ptr to text field
+  */
+void mono_gfx_text_field_invalidate(mono_gfx_text_field_t* field);
+
+/**
+  *@brief gets the area that has changed since the last call and clears it
+  *@param field ptr to text field
+  *@param rect ptr to store dirty area
+  *@return true if anything changed
+  */
+bool mono_gfx_text_field_get_dirty(mono_gfx_text_field_t* field, GFXrect* rect);
+
+#ifdef __cplusplus
+}
+#endif